@@ -0,0 +1,82 @@
+// Copyright 2015 by Martin Moene
+//
+// gsl-lite is based on GSL: Guideline Support Library,
+// https://github.com/microsoft/gsl
+//
+// This code is licensed under the MIT License (MIT).
+//
+
+// Allocation and first-touch cost of dyn_array<> versus std::vector<>:
+// create an array of n ints, write every element once and release it.
+// dyn_array with_default_init does not zero the elements before they are
+// written, std::vector and value-initialized dyn_array do.
+
+#include "gsl-lite.b.h"
+
+#include <vector>
+
+using namespace gsl;
+
+namespace {
+
+void touch( span<int> s )
+{
+    for ( size_t i = 0; i < s.size(); ++i )
+        s[i] = static_cast<int>( i );
+    bench::keep( s[ s.size() / 2 ] );
+}
+
+struct run_vector
+{
+    size_t n;
+    void operator()() const { std::vector<int> v( n ); touch( span<int>( with_container, v ) ); }
+};
+
+struct run_dyn_array
+{
+    size_t n;
+    void operator()() const { dyn_array<int> a( n ); touch( as_span( a ) ); }
+};
+
+struct run_dyn_array_default_init
+{
+    size_t n;
+    void operator()() const { dyn_array<int> a( n, with_default_init ); touch( as_span( a ) ); }
+};
+
+struct run_dyn_array_aligned
+{
+    size_t n;
+    void operator()() const { dyn_array<int, 64> a( n, with_default_init ); touch( as_span( a ) ); }
+};
+
+} // anonymous namespace
+
+int main()
+{
+    bench::configuration();
+
+    size_t const sizes[] = { 256, 64 * 1024, 4 * 1024 * 1024, };
+
+    for ( size_t k = 0; k < gsl_DIMENSION_OF( sizes ); ++k )
+    {
+        size_t const n = sizes[k];
+        double const ops = static_cast<double>( n );
+
+        std::printf( "\n%u ints:\n", static_cast<unsigned>( n ) );
+        bench::compare_header();
+
+        run_vector                 vector       = { n };
+        run_dyn_array              value_init   = { n };
+        run_dyn_array_default_init default_init = { n };
+        run_dyn_array_aligned      aligned      = { n };
+
+        double const ns_vector = bench::ns_per_op( vector, ops );
+
+        bench::compare( "dyn_array<> (per element)",  bench::ns_per_op( value_init,   ops ), ns_vector );
+        bench::compare( "  with_default_init",        bench::ns_per_op( default_init, ops ), ns_vector );
+        bench::compare( "  with_default_init, 64 B",  bench::ns_per_op( aligned,      ops ), ns_vector );
+    }
+}
+
+// end of file
@@ -0,0 +1,102 @@
+// Copyright 2015 by Martin Moene
+//
+// gsl-lite is based on GSL: Guideline Support Library,
+// https://github.com/microsoft/gsl
+//
+// This code is licensed under the MIT License (MIT). 
+//
+
+#pragma once
+
+#ifndef GSL_BENCH_GSL_LITE_H_INCLUDED
+#define GSL_BENCH_GSL_LITE_H_INCLUDED
+
+#include "gsl-lite.h"
+
+#include <cstdio>
+#include <ctime>
+
+#if gsl_CPP11_OR_GREATER
+# include <chrono>
+#endif
+
+namespace bench {
+
+// monotonic time in seconds:
+
+inline double now()
+{
+#if gsl_CPP11_OR_GREATER
+    typedef std::chrono::steady_clock clock;
+    return std::chrono::duration<double>( clock::now().time_since_epoch() ).count();
+#else
+    return static_cast<double>( std::clock() ) / CLOCKS_PER_SEC;
+#endif
+}
+
+// keep results alive so the optimizer cannot drop the measured loop:
+
+template< class T >
+inline void keep( T const & value )
+{
+    static T volatile sink;
+    sink = value;
+    (void) sink;
+}
+
+// run f repeatedly for at least min_seconds, return nanoseconds per operation,
+// where one call of f performs ops_per_call operations:
+
+template< class F >
+double ns_per_op( F f, double ops_per_call, double min_seconds = 0.2 )
+{
+    f(); // warm up
+
+    long calls = 0;
+    double const start = now();
+    double elapsed = 0;
+
+    do
+    {
+        f();
+        ++calls;
+        elapsed = now() - start;
+    }
+    while ( elapsed < min_seconds );
+
+    return 1e9 * elapsed / ( calls * ops_per_call );
+}
+
+inline void report( char const * name, double ns )
+{
+    std::printf( "%-40s %10.3f ns/op\n", name, ns );
+}
+
+// gsl-lite primitive versus hand-written baseline; the abstraction penalty
+// is the ratio of both times, 1.00 meaning no penalty:
+
+inline void compare( char const * name, double ns_gsl, double ns_baseline )
+{
+    std::printf( "%-32s %10.3f %10.3f %8.2f\n", name, ns_gsl, ns_baseline, ns_gsl / ns_baseline );
+}
+
+inline void compare_header()
+{
+    std::printf( "%-32s %10s %10s %8s\n", "primitive (ns/op)", "gsl-lite", "baseline", "penalty" );
+}
+
+// language standard and contract checking this benchmark was compiled for:
+
+inline void configuration()
+{
+    std::printf( "gsl-lite %s, C++%s, contracts %s\n\n",
+        gsl_lite_VERSION,
+        gsl_CPP17_OR_GREATER ? "17" : gsl_CPP14_OR_GREATER ? "14" : gsl_CPP11_OR_GREATER ? "11" : "98",
+        gsl_ELIDE_CONTRACT_EXPECTS ? "off" : "on" );
+}
+
+} // namespace bench
+
+#endif // GSL_BENCH_GSL_LITE_H_INCLUDED
+
+// end of file
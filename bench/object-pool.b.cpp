@@ -0,0 +1,132 @@
+// Copyright 2015 by Martin Moene
+//
+// gsl-lite is based on GSL: Guideline Support Library,
+// https://github.com/microsoft/gsl
+//
+// This code is licensed under the MIT License (MIT).
+//
+
+// object_pool<> versus new and delete under multi-threaded churn: each thread
+// repeatedly creates a handful of small objects and destroys them again.
+// Reported is the wall-clock time per create/destroy pair over all threads.
+
+#include "gsl-lite.b.h"
+
+#if gsl_HAVE_THREAD
+
+#include <thread>
+#include <vector>
+
+using namespace gsl;
+
+namespace {
+
+struct order
+{
+    order( int id_, double price_ ) : id( id_ ), price( price_ ), quantity( 0 ) {}
+
+    int id;
+    double price;
+    long quantity;
+};
+
+const int held_per_round = 16;
+
+struct churn_new
+{
+    void operator()( long rounds ) const
+    {
+        order * held[ held_per_round ];
+        long sum = 0;
+
+        for ( long r = 0; r < rounds; ++r )
+        {
+            for ( int i = 0; i < held_per_round; ++i )
+                held[i] = new order( i, 1.0 );
+            for ( int i = 0; i < held_per_round; ++i )
+            {
+                sum += held[i]->id;
+                delete held[i];
+            }
+        }
+        bench::keep( sum );
+    }
+};
+
+struct churn_pool
+{
+    object_pool<order> * pool;
+
+    void operator()( long rounds ) const
+    {
+        order * held[ held_per_round ];
+        long sum = 0;
+
+        for ( long r = 0; r < rounds; ++r )
+        {
+            for ( int i = 0; i < held_per_round; ++i )
+                held[i] = pool->acquire( i, 1.0 );
+            for ( int i = 0; i < held_per_round; ++i )
+            {
+                sum += held[i]->id;
+                pool->release( held[i] );
+            }
+        }
+        bench::keep( sum );
+    }
+};
+
+// nanoseconds per create/destroy pair with the given number of threads:
+
+template< class F >
+double ns_per_pair( F f, int threads, long rounds )
+{
+    double const start = bench::now();
+
+    std::vector< std::thread > workers;
+    for ( int t = 0; t < threads; ++t )
+        workers.push_back( std::thread( f, rounds ) );
+    for ( int t = 0; t < threads; ++t )
+        workers[t].join();
+
+    return 1e9 * ( bench::now() - start ) / ( double( threads ) * rounds * held_per_round );
+}
+
+} // anonymous namespace
+
+int main()
+{
+    long const rounds = 100 * 1000;
+
+    bench::configuration();
+    bench::compare_header();
+
+    int const threads[] = { 1, 2, 4, 8, };
+
+    for ( size_t k = 0; k < gsl_DIMENSION_OF( threads ); ++k )
+    {
+        object_pool<order> pool;
+        churn_pool with_pool = { &pool };
+
+        char name[40];
+        std::sprintf( name, "object_pool<>, %d thread(s)", threads[k] );
+
+        bench::compare( name, ns_per_pair( with_pool, threads[k], rounds ), ns_per_pair( churn_new(), threads[k], rounds ) );
+
+        object_pool_statistics const s = pool.statistics();
+
+        std::printf( "%-32s hits %llu, misses %llu, allocations %llu, flushes %llu\n", "",
+            s.hits, s.misses, s.allocations, s.flushes );
+    }
+}
+
+#else // gsl_HAVE_THREAD
+
+int main()
+{
+    std::printf( "object_pool<> is not available (no C++11)\n" );
+}
+
+#endif // gsl_HAVE_THREAD
+
+// end of file
@@ -0,0 +1,93 @@
+// Copyright 2015 by Martin Moene
+//
+// gsl-lite is based on GSL: Guideline Support Library,
+// https://github.com/microsoft/gsl
+//
+// This code is licensed under the MIT License (MIT).
+//
+
+// parallel_sort() in place and with a scratch span, with 1 to N participants,
+// versus std::sort() on tens of millions of random 32-bit keys. Reported is
+// the time per element; the ratio below 1.00 is the speedup.
+
+#include "gsl-lite.b.h"
+
+#if gsl_HAVE_THREAD
+
+#include <thread>
+
+using namespace gsl;
+
+namespace {
+
+size_t const elements = 32 * 1024 * 1024;
+int const repetitions = 3;
+
+void randomize( std::vector<unsigned> & v )
+{
+    unsigned x = 12345;
+    for ( size_t i = 0; i < v.size(); ++i )
+    {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        v[i] = x;
+    }
+}
+
+// the fastest of a few sorts of the same random keys, in ns per element:
+
+template< class F >
+double ns_per_element( std::vector<unsigned> & v, F sort )
+{
+    double best = 1e30;
+
+    for ( int r = 0; r < repetitions; ++r )
+    {
+        randomize( v );
+
+        double const start = bench::now();
+        sort();
+        double const seconds = bench::now() - start;
+
+        best = ( std::min )( best, seconds );
+        bench::keep( v[ v.size() / 2 ] );
+    }
+    return 1e9 * best / double( v.size() );
+}
+
+} // anonymous namespace
+
+int main()
+{
+    unsigned const hardware = std::thread::hardware_concurrency();
+
+    bench::configuration();
+    std::printf( "%u hardware thread(s), %u elements\n\n", hardware, static_cast<unsigned>( elements ) );
+    bench::compare_header();
+
+    std::vector<unsigned> v( elements ), scratch( elements );
+
+    double const ns_std = ns_per_element( v, [&]{ std::sort( v.begin(), v.end() ); } );
+
+    for ( unsigned n = 1; n <= ( hardware > 2 ? hardware : 2 ); n *= 2 )
+    {
+        thread_pool pool( n - 1 );
+        char name[40];
+
+        std::sprintf( name, "in place, %u participant(s)", n );
+        bench::compare( name, ns_per_element( v, [&]{ parallel_sort( pool, span<unsigned>( v ) ); } ), ns_std );
+
+        std::sprintf( name, "scratch, %u participant(s)", n );
+        bench::compare( name, ns_per_element( v, [&]{ parallel_sort( pool, span<unsigned>( v ), span<unsigned>( scratch ) ); } ), ns_std );
+    }
+}
+
+#else // gsl_HAVE_THREAD
+
+int main()
+{
+    std::printf( "parallel_sort() is not available (no C++11)\n" );
+}
+
+#endif // gsl_HAVE_THREAD
+
+// end of file
@@ -0,0 +1,134 @@
+// Copyright 2015 by Martin Moene
+//
+// gsl-lite is based on GSL: Guideline Support Library,
+// https://github.com/microsoft/gsl
+//
+// This code is licensed under the MIT License (MIT).
+//
+
+// parallel_transform() and parallel_reduce() on a large span with 1 to N
+// participants versus serial std::transform() and std::accumulate(). Reported
+// is the time per element; the ratio below 1.00 is the speedup.
+
+#include "gsl-lite.b.h"
+
+#if gsl_HAVE_THREAD
+
+#include <cmath>
+#include <numeric>
+#include <thread>
+
+using namespace gsl;
+
+namespace {
+
+size_t const elements = 16 * 1024 * 1024;
+
+struct work
+{
+    float operator()( float x ) const
+    {
+        return std::sqrt( x ) * 0.5f + 1.0f;
+    }
+};
+
+struct serial_transform
+{
+    std::vector<float> const * in;
+    std::vector<float> * out;
+
+    void operator()() const
+    {
+        std::transform( in->begin(), in->end(), out->begin(), work() );
+        bench::keep( ( *out )[ elements / 2 ] );
+    }
+};
+
+struct serial_reduce
+{
+    std::vector<float> const * in;
+
+    void operator()() const
+    {
+        bench::keep( std::accumulate( in->begin(), in->end(), 0.0 ) );
+    }
+};
+
+struct pool_transform
+{
+    thread_pool * pool;
+    std::vector<float> const * in;
+    std::vector<float> * out;
+
+    void operator()() const
+    {
+        parallel_transform( *pool, span<const float>( *in ), span<float>( *out ), work() );
+        bench::keep( ( *out )[ elements / 2 ] );
+    }
+};
+
+struct pool_reduce
+{
+    thread_pool * pool;
+    std::vector<float> const * in;
+    bool ordered;
+
+    void operator()() const
+    {
+        bench::keep( ordered
+            ? parallel_reduce( *pool, span<const float>( *in ), 0.0, std::plus<double>(), in_order )
+            : parallel_reduce( *pool, span<const float>( *in ), 0.0, std::plus<double>() ) );
+    }
+};
+
+} // anonymous namespace
+
+int main()
+{
+    unsigned const hardware = std::thread::hardware_concurrency();
+
+    bench::configuration();
+    std::printf( "%u hardware thread(s), %u elements\n\n", hardware, static_cast<unsigned>( elements ) );
+    bench::compare_header();
+
+    std::vector<float> in( elements ), out( elements );
+    for ( size_t i = 0; i < elements; ++i )
+        in[i] = static_cast<float>( i % 1000 );
+
+    serial_transform const st = { &in, &out };
+    serial_reduce    const sr = { &in };
+
+    double const ns_transform = bench::ns_per_op( st, elements );
+    double const ns_reduce    = bench::ns_per_op( sr, elements );
+
+    for ( unsigned n = 1; n <= ( hardware > 2 ? hardware : 2 ); n *= 2 )
+    {
+        thread_pool pool( n - 1 );
+
+        pool_transform const pt = { &pool, &in, &out };
+        pool_reduce    const pr = { &pool, &in, false };
+        pool_reduce    const po = { &pool, &in, true  };
+
+        char name[40];
+
+        std::sprintf( name, "transform, %u participant(s)", n );
+        bench::compare( name, bench::ns_per_op( pt, elements ), ns_transform );
+
+        std::sprintf( name, "reduce, %u participant(s)", n );
+        bench::compare( name, bench::ns_per_op( pr, elements ), ns_reduce );
+
+        std::sprintf( name, "  in_order" );
+        bench::compare( name, bench::ns_per_op( po, elements ), ns_reduce );
+    }
+}
+
+#else // gsl_HAVE_THREAD
+
+int main()
+{
+    std::printf( "parallel algorithms are not available (no C++11)\n" );
+}
+
+#endif // gsl_HAVE_THREAD
+
+// end of file
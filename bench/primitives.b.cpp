@@ -0,0 +1,360 @@
+// Copyright 2015 by Martin Moene
+//
+// gsl-lite is based on GSL: Guideline Support Library,
+// https://github.com/microsoft/gsl
+//
+// This code is licensed under the MIT License (MIT).
+//
+
+// Time gsl-lite primitives against raw-pointer and hand-written baselines.
+// This source is compiled once per language standard, with contracts on
+// and off (gsl_CONFIG_CONTRACT_LEVEL_OFF), see CMakeLists.txt.
+// The penalty column is gsl-lite time divided by baseline time.
+
+#include "gsl-lite.b.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace gsl;
+
+namespace {
+
+const size_t N = 16 * 1024;
+
+std::vector<int>  ints ( N );
+std::vector<int>  other( N );
+std::vector<long> longs( N );
+std::vector<char> text ( N );
+std::string       text_string;
+
+int volatile counter = 0;
+
+void increment() { ++counter; }
+
+// span iteration:
+
+struct span_iterate
+{
+    void operator()() const
+    {
+        span<const int> s( with_container, ints );
+        int sum = 0;
+        for ( span<const int>::const_iterator pos = s.begin(); pos != s.end(); ++pos )
+            sum += *pos;
+        bench::keep( sum );
+    }
+};
+
+struct raw_iterate
+{
+    void operator()() const
+    {
+        int const * const end = &ints[0] + ints.size();
+        int sum = 0;
+        for ( int const * pos = &ints[0]; pos != end; ++pos )
+            sum += *pos;
+        bench::keep( sum );
+    }
+};
+
+// span indexing, checked by operator[]:
+
+struct span_index
+{
+    void operator()() const
+    {
+        span<const int> s( with_container, ints );
+        int sum = 0;
+        for ( size_t i = 0; i < s.size(); ++i )
+            sum += s[i];
+        bench::keep( sum );
+    }
+};
+
+struct raw_index
+{
+    void operator()() const
+    {
+        int const * const p = &ints[0];
+        int sum = 0;
+        for ( size_t i = 0; i < N; ++i )
+            sum += p[i];
+        bench::keep( sum );
+    }
+};
+
+// copy:
+
+struct span_copy
+{
+    void operator()() const
+    {
+        copy( span<const int>( with_container, ints ), span<int>( with_container, other ) );
+        bench::keep( other[N / 2] );
+    }
+};
+
+struct raw_copy
+{
+    void operator()() const
+    {
+        std::memcpy( &other[0], &ints[0], N * sizeof( int ) );
+        bench::keep( other[N / 2] );
+    }
+};
+
+// comparison:
+
+struct span_equal
+{
+    void operator()() const
+    {
+        bench::keep( span<const int>( with_container, ints ) == span<const int>( with_container, other ) );
+    }
+};
+
+struct raw_equal
+{
+    void operator()() const
+    {
+        bench::keep( 0 == std::memcmp( &ints[0], &other[0], N * sizeof( int ) ) );
+    }
+};
+
+// ensure_z:
+
+struct span_ensure_z
+{
+    void operator()() const
+    {
+        bench::keep( ensure_z( &text[0] ).size() );
+    }
+};
+
+struct raw_strlen
+{
+    void operator()() const
+    {
+        bench::keep( std::strlen( &text[0] ) );
+    }
+};
+
+// find and count, for values that are not present:
+
+struct span_find_char
+{
+    void operator()() const
+    {
+        bench::keep( find( span<const char>( with_container, text ), '#' ) );
+    }
+};
+
+struct raw_memchr
+{
+    void operator()() const
+    {
+        bench::keep( std::memchr( &text[0], '#', N ) );
+    }
+};
+
+struct span_find_int
+{
+    void operator()() const
+    {
+        bench::keep( find( span<const int>( with_container, ints ), -1 ) );
+    }
+};
+
+struct raw_find_int
+{
+    void operator()() const
+    {
+        bench::keep( std::find( &ints[0], &ints[0] + N, -1 ) );
+    }
+};
+
+struct span_count_int
+{
+    void operator()() const
+    {
+        bench::keep( count( span<const int>( with_container, ints ), 7 ) );
+    }
+};
+
+struct raw_count_int
+{
+    void operator()() const
+    {
+        bench::keep( std::count( &ints[0], &ints[0] + N, 7 ) );
+    }
+};
+
+// substring search, for a needle that is not present:
+
+struct span_find_text
+{
+    void operator()() const
+    {
+        bench::keep( find( span<const char>( with_container, text ), ensure_z( "needle" ) ) );
+    }
+};
+
+struct string_find_text
+{
+    void operator()() const
+    {
+        bench::keep( text_string.find( "needle" ) );
+    }
+};
+
+// narrow:
+
+struct gsl_narrow
+{
+    void operator()() const
+    {
+        int sum = 0;
+        for ( size_t i = 0; i < N; ++i )
+            sum += narrow<int>( longs[i] );
+        bench::keep( sum );
+    }
+};
+
+struct raw_cast
+{
+    void operator()() const
+    {
+        int sum = 0;
+        for ( size_t i = 0; i < N; ++i )
+            sum += static_cast<int>( longs[i] );
+        bench::keep( sum );
+    }
+};
+
+// at():
+
+struct gsl_at
+{
+    void operator()() const
+    {
+        int sum = 0;
+        for ( size_t i = 0; i < N; ++i )
+            sum += at( ints, i );
+        bench::keep( sum );
+    }
+};
+
+struct raw_subscript
+{
+    void operator()() const
+    {
+        int sum = 0;
+        for ( size_t i = 0; i < N; ++i )
+            sum += ints[i];
+        bench::keep( sum );
+    }
+};
+
+// not_null access:
+
+int deref( not_null<int const *> p ) { return *p; }
+
+int deref( int const * p ) { return *p; }
+
+struct gsl_not_null
+{
+    void operator()() const
+    {
+        int sum = 0;
+        for ( size_t i = 0; i < N; ++i )
+            sum += deref( not_null<int const *>( &ints[i] ) );
+        bench::keep( sum );
+    }
+};
+
+struct raw_pointer
+{
+    void operator()() const
+    {
+        int sum = 0;
+        for ( size_t i = 0; i < N; ++i )
+            sum += deref( &ints[i] );
+        bench::keep( sum );
+    }
+};
+
+// finally:
+
+struct gsl_finally
+{
+    void operator()() const
+    {
+        for ( size_t i = 0; i < N; ++i )
+        {
+            final_act_type act = finally( &increment );
+        }
+        bench::keep( int( counter ) );
+    }
+#if gsl_CPP11_OR_GREATER
+    typedef final_act<void(*)()> final_act_type;
+#else
+    typedef final_act final_act_type;
+#endif
+};
+
+struct raw_call
+{
+    void operator()() const
+    {
+        for ( size_t i = 0; i < N; ++i )
+        {
+            increment();
+        }
+        bench::keep( int( counter ) );
+    }
+};
+
+template< class G, class B >
+void compare( char const * name, G gsl_version, B baseline, double ops_per_call )
+{
+    bench::compare( name, bench::ns_per_op( gsl_version, ops_per_call ), bench::ns_per_op( baseline, ops_per_call ) );
+}
+
+} // anonymous namespace
+
+int main()
+{
+    for ( size_t i = 0; i < N; ++i )
+    {
+        ints[i]  = int( i % 1000 );
+        other[i] = ints[i];
+        longs[i] = long( i );
+        text[i]  = char( 'a' + i % 26 );
+    }
+    text[N - 1] = '\0';
+    text_string.assign( &text[0], N );
+
+    double const n = static_cast<double>( N );
+
+    bench::configuration();
+    bench::compare_header();
+
+    compare( "span iteration (per element)",   span_iterate  (), raw_iterate     (), n );
+    compare( "span indexing (per element)",    span_index    (), raw_index       (), n );
+    compare( "copy() (per element)",           span_copy     (), raw_copy        (), n );
+    compare( "operator==() (per element)",     span_equal    (), raw_equal       (), n );
+    compare( "ensure_z() (per char)",          span_ensure_z (), raw_strlen      (), n );
+    compare( "find() (per char)",              span_find_char(), raw_memchr      (), n );
+    compare( "find() (per int)",               span_find_int (), raw_find_int    (), n );
+    compare( "count() (per int)",              span_count_int(), raw_count_int   (), n );
+    compare( "find() of a subspan (per char)", span_find_text(), string_find_text(), n );
+    compare( "narrow<>()",                     gsl_narrow    (), raw_cast        (), n );
+    compare( "at()",                           gsl_at        (), raw_subscript   (), n );
+    compare( "not_null<> access",              gsl_not_null  (), raw_pointer     (), n );
+    compare( "finally()",                      gsl_finally   (), raw_call        (), n );
+}
+
+// end of file
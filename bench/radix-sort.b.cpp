@@ -0,0 +1,159 @@
+// Copyright 2015 by Martin Moene
+//
+// gsl-lite is based on GSL: Guideline Support Library,
+// https://github.com/microsoft/gsl
+//
+// This code is licensed under the MIT License (MIT).
+//
+
+// radix_sort() versus std::sort() on random keys of several types, on
+// key/value records and on small keys, where the passes of the constant high
+// bytes are skipped. Reported is the time per element of the fastest of a
+// few sorts.
+
+#include "gsl-lite.b.h"
+
+#include <vector>
+
+using namespace gsl;
+
+namespace {
+
+size_t const elements = 4 * 1024 * 1024;
+int const repetitions = 3;
+
+struct record
+{
+    unsigned key;
+    unsigned value;
+};
+
+bool operator<( record const & a, record const & b )
+{
+    return a.key < b.key;
+}
+
+// random keys, masked to the given bits:
+
+template< class T >
+struct randomize
+{
+    unsigned long long mask;
+
+    void operator()( std::vector<T> & v ) const
+    {
+        unsigned long long x = 88172645463325252ULL;
+        for ( size_t i = 0; i < v.size(); ++i )
+        {
+            x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+            v[i] = static_cast<T>( static_cast<long long>( x & mask ) );
+        }
+    }
+};
+
+template<>
+struct randomize<float>
+{
+    unsigned long long mask;
+
+    void operator()( std::vector<float> & v ) const
+    {
+        std::vector<int> bits( v.size() );
+        randomize<int> const r = { mask };
+        r( bits );
+        for ( size_t i = 0; i < v.size(); ++i )
+            v[i] = static_cast<float>( bits[i] ) / 1e6f;
+    }
+};
+
+template<>
+struct randomize<record>
+{
+    unsigned long long mask;
+
+    void operator()( std::vector<record> & v ) const
+    {
+        std::vector<unsigned> keys( v.size() );
+        randomize<unsigned> const r = { mask };
+        r( keys );
+        for ( size_t i = 0; i < v.size(); ++i )
+        {
+            v[i].key   = keys[i];
+            v[i].value = static_cast<unsigned>( i );
+        }
+    }
+};
+
+template< class T >
+struct sort_std
+{
+    void operator()( std::vector<T> & v, std::vector<T> & ) const
+    {
+        std::sort( v.begin(), v.end() );
+    }
+};
+
+template< class T >
+struct sort_radix
+{
+    void operator()( std::vector<T> & v, std::vector<T> & scratch ) const
+    {
+        radix_sort( span<T>( v ), span<T>( scratch ) );
+    }
+};
+
+template<>
+struct sort_radix<record>
+{
+    void operator()( std::vector<record> & v, std::vector<record> & scratch ) const
+    {
+        radix_sort( span<record>( v ), span<record>( scratch ), &record::key );
+    }
+};
+
+// the fastest of a few sorts of the same random keys, in ns per element:
+
+template< class T, class Sort >
+double ns_per_element( Sort sort, unsigned long long mask )
+{
+    std::vector<T> v( elements ), scratch( elements );
+    randomize<T> const r = { mask };
+    double best = 1e30;
+
+    for ( int i = 0; i < repetitions; ++i )
+    {
+        r( v );
+
+        double const start = bench::now();
+        sort( v, scratch );
+        double const seconds = bench::now() - start;
+
+        best = ( std::min )( best, seconds );
+        bench::keep( &v[ v.size() / 2 ] );
+    }
+    return 1e9 * best / double( elements );
+}
+
+template< class T >
+void compare( char const * name, unsigned long long mask = ~0ULL )
+{
+    bench::compare( name, ns_per_element<T>( sort_radix<T>(), mask ), ns_per_element<T>( sort_std<T>(), mask ) );
+}
+
+} // anonymous namespace
+
+int main()
+{
+    bench::configuration();
+    std::printf( "%u elements, baseline std::sort()\n\n", static_cast<unsigned>( elements ) );
+    bench::compare_header();
+
+    compare<unsigned>          ( "unsigned" );
+    compare<unsigned long long>( "unsigned long long" );
+    compare<int>               ( "int" );
+    compare<float>             ( "float" );
+    compare<record>            ( "record, by unsigned key" );
+    compare<unsigned>          ( "unsigned < 65536", 0xffff );
+}
+
+// end of file
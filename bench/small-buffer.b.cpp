@@ -0,0 +1,143 @@
+// Copyright 2015 by Martin Moene
+//
+// gsl-lite is based on GSL: Guideline Support Library,
+// https://github.com/microsoft/gsl
+//
+// This code is licensed under the MIT License (MIT).
+//
+
+// Heap traffic and time of a temporary small_buffer<> versus std::vector<>:
+// create a buffer of n ints, fill it through a span and release it.
+// Global operator new is replaced to count allocations; with n up to the
+// inline capacity small_buffer should not allocate at all.
+
+#include "gsl-lite.b.h"
+
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace {
+
+long allocations = 0;
+}
+
+#if gsl_CPP11_OR_GREATER
+# define bench_THROWS_BAD_ALLOC
+# define bench_NOTHROW  noexcept
+#else
+# define bench_THROWS_BAD_ALLOC  throw( std::bad_alloc )
+# define bench_NOTHROW  throw()
+#endif
+
+// not inlined, to keep GNUC from pairing malloc() and free() with new and delete:
+
+#if defined( __GNUC__ )
+# define bench_NOINLINE  __attribute__(( noinline ))
+#else
+# define bench_NOINLINE
+#endif
+
+bench_NOINLINE void * operator new( std::size_t size ) bench_THROWS_BAD_ALLOC
+{
+    ++allocations;
+
+    if ( void * p = std::malloc( size ? size : 1 ) )
+        return p;
+
+    throw std::bad_alloc();
+}
+
+bench_NOINLINE void operator delete( void * p ) bench_NOTHROW
+{
+    std::free( p );
+}
+
+#if gsl_CPP14_OR_GREATER
+
+bench_NOINLINE void operator delete( void * p, std::size_t ) bench_NOTHROW
+{
+    std::free( p );
+}
+
+#endif
+
+using namespace gsl;
+
+namespace {
+
+const size_t N = 16;
+
+// buffers created per call:
+
+const int R = 100;
+
+void fill( span<int> s )
+{
+    for ( size_t i = 0; i < s.size(); ++i )
+        s[i] = static_cast<int>( i );
+    bench::keep( s[ s.size() / 2 ] );
+}
+
+struct run_vector
+{
+    size_t n;
+    void operator()() const
+    {
+        for ( int r = 0; r < R; ++r )
+        {
+            std::vector<int> v( n );
+            fill( span<int>( with_container, v ) );
+        }
+    }
+};
+
+struct run_small_buffer
+{
+    size_t n;
+    void operator()() const
+    {
+        for ( int r = 0; r < R; ++r )
+        {
+            small_buffer<int, N> b( n, with_default_init );
+            fill( as_span( b ) );
+        }
+    }
+};
+
+// heap allocations per buffer:
+
+template< class F >
+double allocations_per_buffer( F f )
+{
+    long const before = allocations;
+
+    f();
+
+    return static_cast<double>( allocations - before ) / R;
+}
+
+} // anonymous namespace
+
+int main()
+{
+    bench::configuration();
+
+    std::printf( "per buffer of n ints:\n" );
+    std::printf( "%-32s %10s %10s %10s %10s\n", "small_buffer<int, 16>, n", "allocs", "vector", "ns", "vector" );
+
+    size_t const sizes[] = { 1, 8, 16, 17, 256, };
+
+    for ( size_t k = 0; k < gsl_DIMENSION_OF( sizes ); ++k )
+    {
+        run_vector       vector = { sizes[k] };
+        run_small_buffer buffer = { sizes[k] };
+
+        std::printf( "%-32u %10.2f %10.2f %10.3f %10.3f\n",
+            static_cast<unsigned>( sizes[k] ),
+            allocations_per_buffer( buffer ), allocations_per_buffer( vector ),
+            bench::ns_per_op( buffer, R ), bench::ns_per_op( vector, R ) );
+    }
+}
+
+// end of file
@@ -0,0 +1,107 @@
+// Copyright 2015 by Martin Moene
+//
+// gsl-lite is based on GSL: Guideline Support Library,
+// https://github.com/microsoft/gsl
+//
+// This code is licensed under the MIT License (MIT).
+//
+
+// Compare span storage layouts: pointer+pointer (default) and pointer+length
+// (gsl_CONFIG_SPAN_STORES_LENGTH=1). This source is compiled once per layout;
+// compare the output of span-layout-ptrptr.b and span-layout-ptrlen.b.
+// To inspect the code generated for a loop, compile with -S and look for
+// the function of the same name.
+
+#include "gsl-lite.b.h"
+
+#include <vector>
+
+using namespace gsl;
+
+// an element type with a size that is not a power of two,
+// so that end - begin requires a division by sizeof(record):
+
+struct record
+{
+    int key;
+    int value;
+    int flags;
+};
+
+// index-heavy: size() and operator[] in every iteration
+
+int sum_indexed( span<const record> s )
+{
+    int sum = 0;
+    for ( size_t i = 0; i < s.size(); ++i )
+        sum += s[i].value;
+    return sum;
+}
+
+// iterator-heavy: begin() and end() only
+
+int sum_iterated( span<const record> s )
+{
+    int sum = 0;
+    for ( span<const record>::const_iterator pos = s.begin(); pos != s.end(); ++pos )
+        sum += pos->value;
+    return sum;
+}
+
+// size-heavy: many small sub spans whose size() and bytes() are queried
+
+size_t sum_sizes( span<const record> s )
+{
+    size_t sum = 0;
+    for ( size_t i = 0; i + 4 <= s.size(); i += 4 )
+    {
+        span<const record> part = s.subspan( i, 4 );
+        sum += part.size() + part.bytes();
+    }
+    return sum;
+}
+
+struct run_indexed
+{
+    span<const record> s;
+    void operator()() const { bench::keep( sum_indexed( s ) ); }
+};
+
+struct run_iterated
+{
+    span<const record> s;
+    void operator()() const { bench::keep( sum_iterated( s ) ); }
+};
+
+struct run_sizes
+{
+    span<const record> s;
+    void operator()() const { bench::keep( sum_sizes( s ) ); }
+};
+
+int main()
+{
+    std::vector<record> data( 64 * 1024 );
+    for ( size_t i = 0; i < data.size(); ++i )
+    {
+        record r = { int( i ), int( i % 7 ), 0 };
+        data[i] = r;
+    }
+
+    span<const record> s( with_container, data );
+    double const n = static_cast<double>( s.size() );
+
+    std::printf( "span layout: %s, sizeof(span<record>): %u\n",
+        gsl_CONFIG_SPAN_STORES_LENGTH ? "pointer+length" : "pointer+pointer",
+        static_cast<unsigned>( sizeof( span<record> ) ) );
+
+    run_indexed  indexed  = { s };
+    run_iterated iterated = { s };
+    run_sizes    sizes    = { s };
+
+    bench::report( "index-heavy loop (per element)",    bench::ns_per_op( indexed,  n ) );
+    bench::report( "iterator-heavy loop (per element)", bench::ns_per_op( iterated, n ) );
+    bench::report( "sub span size()/bytes() (per span)", bench::ns_per_op( sizes,    n / 4 ) );
+}
+
+// end of file
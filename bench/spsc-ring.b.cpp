@@ -0,0 +1,193 @@
+// Copyright 2015 by Martin Moene
+//
+// gsl-lite is based on GSL: Guideline Support Library,
+// https://github.com/microsoft/gsl
+//
+// This code is licensed under the MIT License (MIT).
+//
+
+// spsc_ring<> versus a std::deque guarded by a mutex, between two threads
+// pinned to different CPUs where possible. Reported are the throughput as
+// nanoseconds per element transferred, and the latency as nanoseconds per
+// one-way trip of a single element bounced back and forth.
+
+#include "gsl-lite.b.h"
+
+#if gsl_HAVE_THREAD
+
+#include <deque>
+#include <thread>
+
+#if defined(__linux__)
+# include <pthread.h>
+# include <sched.h>
+#endif
+
+using namespace gsl;
+
+namespace {
+
+long const elements = 10 * 1000 * 1000;
+long const trips    = 200 * 1000;
+
+void pin( std::thread & t, unsigned cpu )
+{
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO( &set );
+    CPU_SET( cpu % std::thread::hardware_concurrency(), &set );
+    pthread_setaffinity_np( t.native_handle(), sizeof( set ), &set );
+#else
+    (void) t; (void) cpu;
+#endif
+}
+
+// run producer and consumer on two pinned threads, return elapsed seconds:
+
+template< class P, class C >
+double run( P producer, C consumer )
+{
+    double const start = bench::now();
+
+    std::thread p( producer ), c( consumer );
+    pin( p, 0 );
+    pin( c, 1 );
+    p.join();
+    c.join();
+
+    return bench::now() - start;
+}
+
+// the baseline: a std::deque guarded by a mutex:
+
+struct locked_queue
+{
+    bool try_push( long value )
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        queue.push_back( value );
+        return true;
+    }
+
+    bool try_pop( long & value )
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        if ( queue.empty() )
+            return false;
+        value = queue.front();
+        queue.pop_front();
+        return true;
+    }
+
+    std::deque<long> queue;
+    std::mutex mutex;
+};
+
+// throughput of single elements, for spsc_ring<> and the baseline:
+
+template< class Q >
+double ns_per_element( Q & q )
+{
+    long sum = 0;
+
+    double const seconds = run(
+        [&]{ for ( long i = 0; i < elements; ) if ( q.try_push( i ) ) ++i; else std::this_thread::yield(); },
+        [&]{ long v; for ( long i = 0; i < elements; ) if ( q.try_pop( v ) ) { sum += v; ++i; } else std::this_thread::yield(); } );
+
+    bench::keep( sum );
+    return 1e9 * seconds / elements;
+}
+
+// throughput of elements transferred in spans of up to batch elements:
+
+double ns_per_element_batched( spsc_ring<long> & ring, size_t batch )
+{
+    long sum = 0;
+
+    double const seconds = run(
+        [&]
+        {
+            for ( long i = 0; i < elements; )
+            {
+                ring_regions<long> r = ring.reserve( (std::min)( batch, size_t( elements - i ) ) );
+                for ( size_t k = 0; k < r.first.size();  ++k ) r.first[k]  = i++;
+                for ( size_t k = 0; k < r.second.size(); ++k ) r.second[k] = i++;
+                ring.commit( r.size() );
+                if ( r.empty() ) std::this_thread::yield();
+            }
+        },
+        [&]
+        {
+            for ( long i = 0; i < elements; )
+            {
+                ring_regions<const long> r = ring.peek( batch );
+                for ( size_t k = 0; k < r.first.size();  ++k ) sum += r.first[k];
+                for ( size_t k = 0; k < r.second.size(); ++k ) sum += r.second[k];
+                ring.release( r.size() );
+                i += static_cast<long>( r.size() );
+                if ( r.empty() ) std::this_thread::yield();
+            }
+        } );
+
+    bench::keep( sum );
+    return 1e9 * seconds / elements;
+}
+
+// latency: one element goes to the other thread and back:
+
+template< class Q >
+double ns_per_trip( Q & ping, Q & pong )
+{
+    double const seconds = run(
+        [&]{ long v; for ( long i = 0; i < trips; ++i ) { while ( !ping.try_push( i ) ) {} while ( !pong.try_pop( v ) ) std::this_thread::yield(); } },
+        [&]{ long v; for ( long i = 0; i < trips; ++i ) { while ( !ping.try_pop( v ) ) std::this_thread::yield(); while ( !pong.try_push( v ) ) {} } } );
+
+    return 1e9 * seconds / ( 2.0 * trips );
+}
+
+} // anonymous namespace
+
+int main()
+{
+    bench::configuration();
+    std::printf( "%u hardware thread(s)\n\n", std::thread::hardware_concurrency() );
+    bench::compare_header();
+
+    double baseline = 0;
+    {
+        locked_queue q;
+        baseline = ns_per_element( q );
+    }
+    {
+        spsc_ring<long> ring( 1024 );
+        bench::compare( "spsc_ring<>, per element", ns_per_element( ring ), baseline );
+    }
+
+    size_t const batches[] = { 16, 256, };
+
+    for ( size_t k = 0; k < gsl_DIMENSION_OF( batches ); ++k )
+    {
+        spsc_ring<long> ring( 1024 );
+
+        char name[40];
+        std::sprintf( name, "spsc_ring<>, spans of %u", static_cast<unsigned>( batches[k] ) );
+
+        bench::compare( name, ns_per_element_batched( ring, batches[k] ), baseline );
+    }
+
+    locked_queue ping, pong;
+    spsc_ring<long> ring_ping( 16 ), ring_pong( 16 );
+
+    bench::compare( "spsc_ring<>, latency", ns_per_trip( ring_ping, ring_pong ), ns_per_trip( ping, pong ) );
+}
+
+#else // gsl_HAVE_THREAD
+
+int main()
+{
+    std::printf( "spsc_ring<> is not available (no C++11)\n" );
+}
+
+#endif // gsl_HAVE_THREAD
+
+// end of file
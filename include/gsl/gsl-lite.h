@@ -20,10 +20,13 @@
 #ifndef GSL_GSL_LITE_H_INCLUDED
 #define GSL_GSL_LITE_H_INCLUDED
 
+#include <algorithm>
+#include <cstring>
 #include <exception>
 #include <iterator>
 #include <limits>
 #include <memory>
+#include <new>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -66,6 +69,14 @@
 # define gsl_FEATURE_EXPERIMENTAL_RETURN_GUARD  0
 #endif
 
+#ifndef  gsl_FEATURE_CONCURRENCY
+# define gsl_FEATURE_CONCURRENCY  0
+#endif
+
+#ifndef  gsl_FEATURE_OS_FACILITIES
+# define gsl_FEATURE_OS_FACILITIES  0
+#endif
+
 #ifndef  gsl_CONFIG_CONFIRMS_COMPILATION_ERRORS
 # define gsl_CONFIG_CONFIRMS_COMPILATION_ERRORS  0
 #endif
@@ -78,6 +89,14 @@
 # define gsl_CONFIG_ALLOWS_UNCONSTRAINED_SPAN_CONTAINER_CTOR  1
 #endif
 
+#ifndef  gsl_CONFIG_SPAN_STORES_LENGTH
+# define gsl_CONFIG_SPAN_STORES_LENGTH  0
+#endif
+
+#ifndef  gsl_CONFIG_CONTRACT_COUNTERS
+# define gsl_CONFIG_CONTRACT_COUNTERS  0
+#endif
+
 #if    defined( gsl_CONFIG_CONTRACT_LEVEL_ON )
 # define        gsl_CONFIG_CONTRACT_LEVEL_MASK  0x11
 #elif  defined( gsl_CONFIG_CONTRACT_LEVEL_OFF )
@@ -146,6 +165,11 @@
 # define gsl_HAVE_IS_DEFAULT  1
 # define gsl_HAVE_IS_DELETE  1
 # define gsl_HAVE_NOEXCEPT  1
+# define gsl_HAVE_VARIADIC_TEMPLATES  1
+#endif
+
+#if gsl_CPP11_OR_GREATER || gsl_COMPILER_MSVC_VERSION >= 10
+# define gsl_HAVE_STATIC_ASSERT  1
 #endif
 
 #if gsl_CPP11_OR_GREATER
@@ -187,6 +211,38 @@
 # define gsl_HAVE_TYPE_TRAITS  1
 #endif
 
+#if gsl_FEATURE_CONCURRENCY && ( gsl_CPP11_OR_GREATER || gsl_COMPILER_MSVC_VERSION >= 14 )
+# define gsl_HAVE_THREAD  1
+#endif
+
+// Presence of instruction set extensions (x86, x64):
+
+#if defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+# define gsl_HAVE_SSE2  1
+#endif
+
+#if defined(__AVX2__)
+# define gsl_HAVE_AVX2  1
+#endif
+
+// copies of at least this many bytes use non-temporal stores, by default those
+// larger than a typical last-level cache, see copy():
+
+#ifndef  gsl_CONFIG_NONTEMPORAL_COPY_THRESHOLD
+# if gsl_HAVE_SSE2
+#  define gsl_CONFIG_NONTEMPORAL_COPY_THRESHOLD  8388608
+# else
+#  define gsl_CONFIG_NONTEMPORAL_COPY_THRESHOLD  0
+# endif
+#endif
+
+// Presence of operating system facilities (POSIX), on request:
+
+#if gsl_FEATURE_OS_FACILITIES && ( defined(__unix__) || defined(__APPLE__) )
+# define gsl_HAVE_MMAP  1
+# define gsl_HAVE_UIO   1
+#endif
+
 // For the rest, consider VC12, VC14 as C++11 for GSL Lite:
 
 #if gsl_COMPILER_MSVC_VERSION >= 12
@@ -226,6 +282,32 @@
 
 #define gsl_DIMENSION_OF( a ) ( sizeof(a) / sizeof(0[a]) )
 
+// for functions that intentionally read whole aligned blocks beyond an object:
+
+#if defined(__clang__) || gsl_COMPILER_GCC_VERSION >= 480
+# define gsl_NO_SANITIZE_ADDRESS  __attribute__(( no_sanitize_address ))
+#else
+# define gsl_NO_SANITIZE_ADDRESS  /*no_sanitize_address*/
+#endif
+
+// for slow paths that should stay out of line from their fast path:
+
+#if defined(__clang__) || defined(__GNUC__)
+# define gsl_NOINLINE  __attribute__(( noinline ))
+#elif gsl_COMPILER_MSVC_VERSION >= 8
+# define gsl_NOINLINE  __declspec( noinline )
+#else
+# define gsl_NOINLINE  /*noinline*/
+#endif
+
+// compile-time check, also usable pre-C++11 (inside function bodies):
+
+#if gsl_HAVE_STATIC_ASSERT
+# define gsl_STATIC_ASSERT( expr, text )  static_assert( expr, text )
+#else
+# define gsl_STATIC_ASSERT( expr, text )  ( void ) sizeof( ::gsl::detail::static_assertion< ( expr ) > )
+#endif
+
 #if gsl_HAVE_ARRAY
 # include <array>
 #endif
@@ -238,6 +320,54 @@
 # include <cstdint>
 #endif
 
+#if gsl_HAVE_SSE2
+# include <emmintrin.h>
+#endif
+
+#if gsl_HAVE_AVX2
+# include <immintrin.h>
+#endif
+
+#if gsl_COMPILER_MSVC_VERSION >= 8
+# include <intrin.h>
+#endif
+
+#if gsl_HAVE_THREAD
+# include <atomic>
+# include <condition_variable>
+# include <functional>
+# include <mutex>
+# include <thread>
+#endif
+
+#if gsl_HAVE_MMAP || gsl_HAVE_UIO
+# include <cerrno>
+# include <unistd.h>
+# if gsl_CPP11_OR_GREATER
+#  include <system_error>
+# endif
+#endif
+
+#if gsl_HAVE_MMAP
+# include <cstdlib>
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+#endif
+
+#if gsl_HAVE_UIO
+# include <sys/uio.h>
+#endif
+
+#if gsl_CONFIG_CONTRACT_COUNTERS
+# if !( gsl_CPP11_OR_GREATER || gsl_COMPILER_MSVC_VERSION >= 14 )
+#  error gsl_CONFIG_CONTRACT_COUNTERS requires C++11 (atomic, mutex, thread_local).
+# endif
+# include <atomic>
+# include <cstdio>
+# include <mutex>
+#endif
+
 // Other features:
 
 // Note: !defined(__NVCC__) doesn't work with nvcc here:
@@ -287,20 +417,30 @@ namespace gsl {
 #define gsl_ELIDE_CONTRACT_EXPECTS  ( 0 == ( gsl_CONFIG_CONTRACT_LEVEL_MASK & 0x01 ) )
 #define gsl_ELIDE_CONTRACT_ENSURES  ( 0 == ( gsl_CONFIG_CONTRACT_LEVEL_MASK & 0x10 ) )
 
+// each site registers its counters once, on first evaluation; the condition is
+// stringized by Expects() and Ensures(), before its macros are expanded:
+
+#if gsl_CONFIG_CONTRACT_COUNTERS
+# define gsl_CONTRACT_COUNT( kind, x, text )  ::gsl::detail::count_contract( (x), []() -> ::gsl::detail::contract_site & \
+    { static ::gsl::detail::contract_site & site = ::gsl::detail::register_contract_site( kind, text, __FILE__, __LINE__ ); return site; }() )
+#else
+# define gsl_CONTRACT_COUNT( kind, x, text )  (x)
+#endif
+
 #if gsl_ELIDE_CONTRACT_EXPECTS
 # define Expects( x )  /* Expects elided */
 #elif gsl_CONFIG_CONTRACT_VIOLATION_THROWS_V
-# define Expects( x )  ::gsl::fail_fast_assert( (x), "GSL: Precondition failure at " __FILE__ ": " gsl_STRINGIFY(__LINE__) );
+# define Expects( x )  ::gsl::fail_fast_assert( gsl_CONTRACT_COUNT( "Expects", x, #x ), "GSL: Precondition failure at " __FILE__ ": " gsl_STRINGIFY(__LINE__) );
 #else
-# define Expects( x )  ::gsl::fail_fast_assert( (x) )
+# define Expects( x )  ::gsl::fail_fast_assert( gsl_CONTRACT_COUNT( "Expects", x, #x ) )
 #endif
 
 #if gsl_ELIDE_CONTRACT_ENSURES
 # define Ensures( x )  /* Ensures elided */
 #elif gsl_CONFIG_CONTRACT_VIOLATION_THROWS_V
-# define Ensures( x )  ::gsl::fail_fast_assert( (x), "GSL: Postcondition failure at " __FILE__ ": " gsl_STRINGIFY(__LINE__) );
+# define Ensures( x )  ::gsl::fail_fast_assert( gsl_CONTRACT_COUNT( "Ensures", x, #x ), "GSL: Postcondition failure at " __FILE__ ": " gsl_STRINGIFY(__LINE__) );
 #else
-# define Ensures( x )  ::gsl::fail_fast_assert( (x) )
+# define Ensures( x )  ::gsl::fail_fast_assert( gsl_CONTRACT_COUNT( "Ensures", x, #x ) )
 #endif
 
 #define gsl_STRINGIFY(  x )  gsl_STRINGIFY_( x )
@@ -330,6 +470,199 @@ gsl_api inline void fail_fast_assert( bool cond )
 
 #endif // gsl_CONFIG_CONTRACT_VIOLATION_THROWS_V
 
+#if gsl_CONFIG_CONTRACT_COUNTERS
+
+//
+// contract counters: evaluations and failures per contract site (host code only).
+//
+
+struct contract_counter
+{
+    char const * kind;          // "Expects" or "Ensures"
+    char const * condition;
+    char const * file;
+    int line;
+    unsigned long long evaluations;
+    unsigned long long failures;
+};
+
+namespace detail {
+
+// counters of one contract site, split into shards a cache line apart so that
+// threads that use different shards do not contend:
+
+const size_t contract_shards = 8;
+
+struct contract_shard
+{
+    contract_shard() : evaluations( 0 ), failures( 0 ) {}
+
+    std::atomic<unsigned long long> evaluations;
+    std::atomic<unsigned long long> failures;
+    char padding[ 64 - 2 * sizeof( std::atomic<unsigned long long> ) ];
+};
+
+struct contract_site
+{
+    contract_site( char const * kind_, char const * condition_, char const * file_, int line_ )
+        : kind( kind_ ), condition( condition_ ), file( file_ ), line( line_ ) {}
+
+    char const * kind;
+    char const * condition;
+    char const * file;
+    int line;
+    contract_shard shards[ contract_shards ];
+};
+
+// the sites of the program, one per site however many threads evaluate it;
+// sites are never destroyed, so that contracts may be counted during static
+// destruction:
+
+struct contract_registry
+{
+    std::mutex mutex;
+    std::vector< contract_site * > sites;
+};
+
+inline contract_registry & contract_sites()
+{
+    static contract_registry * registry = new contract_registry();
+    return *registry;
+}
+
+// new counters for a site, registered for contract_counters():
+
+inline contract_site & register_contract_site( char const * kind, char const * condition, char const * file, int line )
+{
+    contract_registry & registry = contract_sites();
+    std::lock_guard<std::mutex> lock( registry.mutex );
+    registry.sites.push_back( new contract_site( kind, condition, file, line ) );
+    return *registry.sites.back();
+}
+
+// the shard of the calling thread, threads are assigned shards in turn:
+
+inline size_t contract_shard_index()
+{
+    static std::atomic<size_t> next( 0 );
+    static thread_local size_t const index = next.fetch_add( 1, std::memory_order_relaxed ) % contract_shards;
+    return index;
+}
+
+inline bool count_contract( bool cond, contract_site & site )
+{
+    contract_shard & shard = site.shards[ contract_shard_index() ];
+
+    shard.evaluations.fetch_add( 1, std::memory_order_relaxed );
+    if ( !cond )
+        shard.failures.fetch_add( 1, std::memory_order_relaxed );
+
+    return cond;
+}
+
+inline unsigned long long sum_shards( std::atomic<unsigned long long> contract_shard::* counter, contract_site const & site )
+{
+    unsigned long long sum = 0;
+    for ( size_t i = 0; i < contract_shards; ++i )
+        sum += ( site.shards[i].*counter ).load( std::memory_order_relaxed );
+    return sum;
+}
+
+inline bool less_site( contract_counter const & a, contract_counter const & b )
+{
+    int const by_file = std::strcmp( a.file, b.file );
+    if ( by_file != 0 ) return by_file < 0;
+    if ( a.line  != b.line ) return a.line < b.line;
+    int const by_kind = std::strcmp( a.kind, b.kind );
+    if ( by_kind != 0 ) return by_kind < 0;
+    return std::strcmp( a.condition, b.condition ) < 0;
+}
+
+inline bool same_site( contract_counter const & a, contract_counter const & b )
+{
+    return !less_site( a, b ) && !less_site( b, a );
+}
+
+inline bool more_evaluations( contract_counter const & a, contract_counter const & b )
+{
+    return a.evaluations > b.evaluations;
+}
+} // namespace detail
+
+// counters of all contract sites evaluated so far, summed over threads,
+// ordered by file and line:
+
+inline std::vector<contract_counter> contract_counters()
+{
+    std::vector<contract_counter> result;
+    {
+        detail::contract_registry & registry = detail::contract_sites();
+        std::lock_guard<std::mutex> lock( registry.mutex );
+
+        for ( size_t i = 0; i < registry.sites.size(); ++i )
+        {
+            detail::contract_site const & site = *registry.sites[i];
+            contract_counter const counter = { site.kind, site.condition, site.file, site.line,
+                detail::sum_shards( &detail::contract_shard::evaluations, site ), detail::sum_shards( &detail::contract_shard::failures, site ) };
+            result.push_back( counter );
+        }
+    }
+
+    std::sort( result.begin(), result.end(), detail::less_site );
+
+    // merge the counters of the same site from different template instantiations or translation units:
+
+    size_t n = 0;
+    for ( size_t i = 0; i < result.size(); ++i )
+    {
+        if ( n > 0 && detail::same_site( result[n - 1], result[i] ) )
+        {
+            result[n - 1].evaluations += result[i].evaluations;
+            result[n - 1].failures    += result[i].failures;
+        }
+        else
+        {
+            result[n++] = result[i];
+        }
+    }
+    result.resize( n );
+    return result;
+}
+
+// reset all counters; counts made concurrently by other threads may be lost:
+
+inline void reset_contract_counters()
+{
+    detail::contract_registry & registry = detail::contract_sites();
+    std::lock_guard<std::mutex> lock( registry.mutex );
+
+    for ( size_t i = 0; i < registry.sites.size(); ++i )
+    {
+        for ( size_t k = 0; k < detail::contract_shards; ++k )
+        {
+            registry.sites[i]->shards[k].evaluations.store( 0, std::memory_order_relaxed );
+            registry.sites[i]->shards[k].failures   .store( 0, std::memory_order_relaxed );
+        }
+    }
+}
+
+// print all counters, most evaluated (hottest) contract sites first:
+
+inline void print_contract_counters( std::FILE * out = stderr )
+{
+    std::vector<contract_counter> counters = contract_counters();
+    std::stable_sort( counters.begin(), counters.end(), detail::more_evaluations );
+
+    for ( size_t i = 0; i < counters.size(); ++i )
+    {
+        std::fprintf( out, "%s:%d: %s( %s ): %llu evaluations, %llu failures\n",
+            counters[i].file, counters[i].line, counters[i].kind, counters[i].condition,
+            counters[i].evaluations, counters[i].failures );
+    }
+}
+
+#endif // gsl_CONFIG_CONTRACT_COUNTERS
+
 //
 // GSL.util: utilities
 //
@@ -648,11 +981,19 @@ gsl_api const T & at( std::initializer_list<T> cont, size_t index )
 }
 #endif
 
-template< class T >
+// extent of a span whose size is only known at run time:
+
+const size_t dynamic_extent = static_cast<size_t>( -1 );
+
+template< class T, size_t Extent = dynamic_extent >
 class span;
 
-template< class T >
-gsl_api T & at( span<T> s, size_t index )
+template< class T > class chunk_view;
+template< class T > class window_view;
+template< class T > class aligned_chunk_view;
+
+template< class T, size_t Extent >
+gsl_api T & at( span<T, Extent> s, size_t index )
 {
     return s.at( index );
 }
@@ -759,7 +1100,7 @@ template< class T >
 gsl_api inline gsl_constexpr byte to_byte( T v ) gsl_noexcept
 {
 #if    gsl_HAVE_ENUM_CLASS_CONSTRUCTION_FROM_UNDERLYING_TYPE
-    static_assert( false, "Implement to_byte() using conversion from underlying type." );
+    return byte{ static_cast<unsigned char>( v ) };
 #elif  gsl_HAVE_CONSTEXPR_11
     return { static_cast<typename byte::type>( v ) };
 #else
@@ -771,7 +1112,7 @@ template< class IntegerType  gsl_ENABLE_IF_INTEGRAL_T( IntegerType ) >
 gsl_api inline gsl_constexpr IntegerType to_integer( byte b ) gsl_noexcept
 {
 #if gsl_HAVE_ENUM_CLASS_CONSTRUCTION_FROM_UNDERLYING_TYPE
-    static_assert( false, "Implement to_integer() using conversion from underlying type." );
+    return static_cast<IntegerType>( b );
 #else
     return b.v;
 #endif
@@ -898,128 +1239,368 @@ gsl_api inline gsl_constexpr byte operator~( byte b ) gsl_noexcept
 struct with_container_t{ gsl_constexpr14 with_container_t(){} };
 const with_container_t with_container;
 
-//
-// span<> - A 1D view of contiguous T's, replace (*,len).
-//
-template< class T >
-class span
-{
-    template< class U > friend class span;
+namespace detail {
 
-public:
-    typedef size_t size_type;       // deprecated since version 0.12.0
-    typedef size_t index_type;      // p0122r3 uses std::ptrdiff_t
+// only the true case is complete, see gsl_STATIC_ASSERT():
+template< bool > struct static_assertion;
+template<> struct static_assertion<true> {};
 
-    typedef T element_type;
-    typedef T & reference;
-    typedef T * pointer;
-    typedef T const * const_pointer;
-    typedef T const & const_reference;
+// minimal type traits that are also available pre-C++11:
 
-    typedef pointer       iterator;
-    typedef const_pointer const_iterator;
+template< bool B > struct bool_constant { enum { value = B }; };
 
-#if gsl_BETWEEN( gsl_COMPILER_MSVC_VERSION, 6, 7 )
-    typedef std::reverse_iterator< iterator, T >             reverse_iterator;
-    typedef std::reverse_iterator< const_iterator, const T > const_reverse_iterator;
+typedef bool_constant<true > true_type;
+typedef bool_constant<false> false_type;
+
+template< class T, class U > struct is_same       { enum { value = false }; };
+template< class T          > struct is_same<T, T> { enum { value = true  }; };
+
+template< class T > struct remove_const            { typedef T type; };
+template< class T > struct remove_const< T const > { typedef T type; };
+
+template< class T > struct remove_cv                     { typedef T type; };
+template< class T > struct remove_cv< T const >          { typedef T type; };
+template< class T > struct remove_cv< T volatile >       { typedef T type; };
+template< class T > struct remove_cv< T const volatile > { typedef T type; };
+
+template< class T > struct is_volatile                { enum { value = false }; };
+template< class T > struct is_volatile< T volatile >  { enum { value = true  }; };
+
+template< class T > struct is_const                   { enum { value = false }; };
+template< class T > struct is_const< T const >        { enum { value = true  }; };
+
+// types whose values are equal if and only if their object representations are equal:
+
+#if gsl_HAVE_TYPE_TRAITS
+template< class T > struct has_unique_representation_
+{
+    enum { value = std::is_integral<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value };
+};
 #else
-    typedef std::reverse_iterator< iterator >                reverse_iterator;
-    typedef std::reverse_iterator< const_iterator >          const_reverse_iterator;
+template< class T > struct has_unique_representation_      { enum { value = false }; };
+template< class T > struct has_unique_representation_<T *> { enum { value = true  }; };
+template<> struct has_unique_representation_<bool          > { enum { value = true }; };
+template<> struct has_unique_representation_<char          > { enum { value = true }; };
+template<> struct has_unique_representation_<signed char   > { enum { value = true }; };
+template<> struct has_unique_representation_<unsigned char > { enum { value = true }; };
+template<> struct has_unique_representation_<wchar_t       > { enum { value = true }; };
+template<> struct has_unique_representation_<short         > { enum { value = true }; };
+template<> struct has_unique_representation_<unsigned short> { enum { value = true }; };
+template<> struct has_unique_representation_<int           > { enum { value = true }; };
+template<> struct has_unique_representation_<unsigned int  > { enum { value = true }; };
+template<> struct has_unique_representation_<long          > { enum { value = true }; };
+template<> struct has_unique_representation_<unsigned long > { enum { value = true }; };
 #endif
 
-    typedef typename std::iterator_traits< iterator >::difference_type difference_type;
+template< class T > struct has_unique_representation
+    : bool_constant< has_unique_representation_<T>::value || is_same<T, byte>::value > {};
 
-    gsl_api gsl_constexpr14 span()
-        : begin_( NULL )
-        , end_  ( NULL )
-    {
-        Expects( size() == 0 );
-    }
+// types that may be copied as their object representation:
 
-#if gsl_HAVE_NULLPTR
-    gsl_api gsl_constexpr14 span( std::nullptr_t, size_type size_in )
-        : begin_( nullptr )
-        , end_  ( nullptr )
-    {
-        Expects( size_in == 0 );
-    }
+#if gsl_HAVE_TYPE_TRAITS
+# if gsl_BETWEEN( gsl_COMPILER_GCC_VERSION, 1, 500 )
+template< class T > struct is_trivially_copyable { enum { value = std::is_trivial<T>::value }; };
+# else
+template< class T > struct is_trivially_copyable { enum { value = std::is_trivially_copyable<T>::value }; };
+# endif
+#else
+template< class T > struct is_trivially_copyable { enum { value = has_unique_representation<T>::value }; };
+template<> struct is_trivially_copyable<float      > { enum { value = true }; };
+template<> struct is_trivially_copyable<double     > { enum { value = true }; };
+template<> struct is_trivially_copyable<long double> { enum { value = true }; };
 #endif
 
-#if gsl_HAVE_IS_DELETE
-    gsl_api gsl_constexpr14 span( reference data_in )
-        : span( &data_in, 1 )
-    {}
+// elements of span<T> may be copied to span<U> as bytes:
 
-    gsl_api gsl_constexpr14 span( element_type && ) = delete;
+template< class T, class U >
+struct is_bytewise_copyable
+    : bool_constant< is_same< typename remove_const<T>::type, U >::value && ! is_volatile<U>::value && is_trivially_copyable<U>::value > {};
+
+// elements of span<T> and span<U> may be compared for equality as bytes:
+
+template< class T, class U >
+struct is_bytewise_comparable
+    : bool_constant< is_same< typename remove_cv<T>::type, typename remove_cv<U>::type >::value
+        && ! is_volatile<T>::value && ! is_volatile<U>::value
+        && has_unique_representation< typename remove_cv<T>::type >::value > {};
+
+// index of lowest set bit, x must not be 0:
+
+gsl_api inline int count_trailing_zeros( unsigned x )
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz( x );
+#elif gsl_COMPILER_MSVC_VERSION >= 8
+    unsigned long index;
+    _BitScanForward( &index, x );
+    return static_cast<int>( index );
+#else
+    int n = 0;
+    for ( ; 0 == ( x & 1u ); x >>= 1 )
+        ++n;
+    return n;
 #endif
+}
 
-    gsl_api gsl_constexpr14 span( pointer begin_in, pointer end_in )
-        : begin_( begin_in )
-        , end_  ( end_in )
-    {
-        Expects( begin_in <= end_in );
-    }
+// unsigned integral type of E bytes:
 
-    gsl_api gsl_constexpr14 span( pointer data_in, size_type size_in )
-        : begin_( data_in )
-        , end_  ( data_in + size_in )
-    {
-        Expects( size_in == 0 || ( size_in > 0 && data_in != NULL ) );
-    }
+template< size_t E > struct uint_of_size;
+template<> struct uint_of_size<1> { typedef unsigned char  type; };
+template<> struct uint_of_size<2> { typedef unsigned short type; };
+template<> struct uint_of_size<4> { typedef unsigned int   type; };
 
-    template< typename U >
-    gsl_api gsl_constexpr14 span( U * & data_in, size_type size_in )
-        : begin_( data_in )
-        , end_  ( data_in + size_in )
-    {
-        Expects( size_in == 0 || ( size_in > 0 && data_in != NULL ) );
-    }
+// object representation of v as an integral type of the same size:
 
-    template< typename U >
-    gsl_api gsl_constexpr14 span( U * const & data_in, size_type size_in )
-        : begin_( data_in )
-        , end_  ( data_in + size_in )
-    {
-        Expects( size_in == 0 || ( size_in > 0 && data_in != NULL ) );
-    }
+template< class To, class From >
+inline To to_bits( From const & v )
+{
+    To t;
+    std::memcpy( &t, &v, sizeof( t ) );
+    return t;
+}
 
-    template< class U, size_t N >
-    gsl_api gsl_constexpr14 span( U (&arr)[N] )
-        : begin_( arr )
-        , end_  ( arr + N )
-    {}
+// SIMD vectors of elements of 1, 2 or 4 bytes; mask() yields one bit per byte:
 
-#if gsl_HAVE_ARRAY
-    template< class U, size_t N >
-    gsl_api gsl_constexpr14 span( std::array< U, N > & arr )
-        : begin_( arr.data() )
-        , end_  ( arr.data() + N )
-    {}
-#endif
+#if gsl_HAVE_AVX2
 
-#if gsl_HAVE_DEFAULT_FUNCTION_TEMPLATE_ARG && gsl_HAVE_CONTAINER_DATA_METHOD
-# define gsl_HAVE_CONSTRAINED_SPAN_CONTAINER_CTOR   1
-#endif
+typedef __m256i simd_vector;
 
-#if gsl_HAVE_CONSTRAINED_SPAN_CONTAINER_CTOR
-    // SFINAE enable only if Cont has a data() member function
-    template< class Cont, typename = decltype(std::declval<Cont>().data()) >
+enum { simd_width = 32 };
+
+gsl_NO_SANITIZE_ADDRESS
+inline simd_vector simd_load( char const * p )
+{
+    return _mm256_load_si256( reinterpret_cast<simd_vector const *>( p ) );
+}
+
+inline simd_vector simd_loadu( char const * p )
+{
+    return _mm256_loadu_si256( reinterpret_cast<simd_vector const *>( p ) );
+}
+
+inline unsigned simd_mask( simd_vector v )
+{
+    return static_cast<unsigned>( _mm256_movemask_epi8( v ) );
+}
+
+inline simd_vector simd_or( simd_vector a, simd_vector b )
+{
+    return _mm256_or_si256( a, b );
+}
+
+template< size_t E > struct simd_lanes;
+
+template<> struct simd_lanes<1>
+{
+    template< class T > static simd_vector splat( T v ) { return _mm256_set1_epi8( to_bits<char>( v ) ); }
+    static simd_vector equal( simd_vector a, simd_vector b ) { return _mm256_cmpeq_epi8( a, b ); }
+    static simd_vector sub  ( simd_vector a, simd_vector b ) { return _mm256_sub_epi8( a, b ); }
+};
+
+template<> struct simd_lanes<2>
+{
+    template< class T > static simd_vector splat( T v ) { return _mm256_set1_epi16( to_bits<short>( v ) ); }
+    static simd_vector equal( simd_vector a, simd_vector b ) { return _mm256_cmpeq_epi16( a, b ); }
+    static simd_vector sub  ( simd_vector a, simd_vector b ) { return _mm256_sub_epi16( a, b ); }
+};
+
+template<> struct simd_lanes<4>
+{
+    template< class T > static simd_vector splat( T v ) { return _mm256_set1_epi32( to_bits<int>( v ) ); }
+    static simd_vector equal( simd_vector a, simd_vector b ) { return _mm256_cmpeq_epi32( a, b ); }
+    static simd_vector sub  ( simd_vector a, simd_vector b ) { return _mm256_sub_epi32( a, b ); }
+};
+
+#elif gsl_HAVE_SSE2
+
+typedef __m128i simd_vector;
+
+enum { simd_width = 16 };
+
+gsl_NO_SANITIZE_ADDRESS
+inline simd_vector simd_load( char const * p )
+{
+    return _mm_load_si128( reinterpret_cast<simd_vector const *>( p ) );
+}
+
+inline simd_vector simd_loadu( char const * p )
+{
+    return _mm_loadu_si128( reinterpret_cast<simd_vector const *>( p ) );
+}
+
+inline unsigned simd_mask( simd_vector v )
+{
+    return static_cast<unsigned>( _mm_movemask_epi8( v ) );
+}
+
+inline simd_vector simd_or( simd_vector a, simd_vector b )
+{
+    return _mm_or_si128( a, b );
+}
+
+template< size_t E > struct simd_lanes;
+
+template<> struct simd_lanes<1>
+{
+    template< class T > static simd_vector splat( T v ) { return _mm_set1_epi8( to_bits<char>( v ) ); }
+    static simd_vector equal( simd_vector a, simd_vector b ) { return _mm_cmpeq_epi8( a, b ); }
+    static simd_vector sub  ( simd_vector a, simd_vector b ) { return _mm_sub_epi8( a, b ); }
+};
+
+template<> struct simd_lanes<2>
+{
+    template< class T > static simd_vector splat( T v ) { return _mm_set1_epi16( to_bits<short>( v ) ); }
+    static simd_vector equal( simd_vector a, simd_vector b ) { return _mm_cmpeq_epi16( a, b ); }
+    static simd_vector sub  ( simd_vector a, simd_vector b ) { return _mm_sub_epi16( a, b ); }
+};
+
+template<> struct simd_lanes<4>
+{
+    template< class T > static simd_vector splat( T v ) { return _mm_set1_epi32( to_bits<int>( v ) ); }
+    static simd_vector equal( simd_vector a, simd_vector b ) { return _mm_cmpeq_epi32( a, b ); }
+    static simd_vector sub  ( simd_vector a, simd_vector b ) { return _mm_sub_epi32( a, b ); }
+};
+
+#endif // gsl_HAVE_AVX2, gsl_HAVE_SSE2
+
+// elements that may be searched for a value in parallel, as above:
+
+template< class T >
+struct is_simd_searchable
+    : bool_constant< has_unique_representation< typename remove_cv<T>::type >::value && ! is_volatile<T>::value
+        && ( sizeof( T ) == 1 || sizeof( T ) == 2 || sizeof( T ) == 4 ) > {};
+}
+
+//
+// span<> - A 1D view of contiguous T's, replace (*,len).
+//
+// span<T> has a size that is determined at run time (dynamic_extent),
+// span<T, N> has a size of N elements that is fixed at compile time.
+//
+template< class T >
+class span< T, dynamic_extent >
+{
+    template< class U, size_t N > friend class span;
+    template< class U > friend class chunk_view;
+    template< class U > friend class window_view;
+    template< class U > friend class aligned_chunk_view;
+
+public:
+    typedef size_t size_type;       // deprecated since version 0.12.0
+    typedef size_t index_type;      // p0122r3 uses std::ptrdiff_t
+
+    static const index_type extent = dynamic_extent;
+
+    typedef T element_type;
+    typedef T & reference;
+    typedef T * pointer;
+    typedef T const * const_pointer;
+    typedef T const & const_reference;
+
+    typedef pointer       iterator;
+    typedef const_pointer const_iterator;
+
+#if gsl_BETWEEN( gsl_COMPILER_MSVC_VERSION, 6, 7 )
+    typedef std::reverse_iterator< iterator, T >             reverse_iterator;
+    typedef std::reverse_iterator< const_iterator, const T > const_reverse_iterator;
+#else
+    typedef std::reverse_iterator< iterator >                reverse_iterator;
+    typedef std::reverse_iterator< const_iterator >          const_reverse_iterator;
+#endif
+
+    typedef typename std::iterator_traits< iterator >::difference_type difference_type;
+
+    gsl_api gsl_constexpr14 span()
+        : begin_( NULL )
+        , limit_( make_limit( NULL, index_type( 0 ) ) )
+    {
+        Expects( size() == 0 );
+    }
+
+#if gsl_HAVE_NULLPTR
+    gsl_api gsl_constexpr14 span( std::nullptr_t, size_type size_in )
+        : begin_( nullptr )
+        , limit_( make_limit( nullptr, index_type( 0 ) ) )
+    {
+        Expects( size_in == 0 );
+    }
+#endif
+
+#if gsl_HAVE_IS_DELETE
+    gsl_api gsl_constexpr14 span( reference data_in )
+        : span( &data_in, 1 )
+    {}
+
+    gsl_api gsl_constexpr14 span( element_type && ) = delete;
+#endif
+
+    gsl_api gsl_constexpr14 span( pointer begin_in, pointer end_in )
+        : begin_( begin_in )
+        , limit_( make_limit( begin_in, end_in ) )
+    {
+        Expects( begin_in <= end_in );
+    }
+
+    gsl_api gsl_constexpr14 span( pointer data_in, size_type size_in )
+        : begin_( data_in )
+        , limit_( make_limit( data_in, size_in ) )
+    {
+        Expects( size_in == 0 || ( size_in > 0 && data_in != NULL ) );
+    }
+
+    template< typename U >
+    gsl_api gsl_constexpr14 span( U * & data_in, size_type size_in )
+        : begin_( data_in )
+        , limit_( make_limit( data_in, size_in ) )
+    {
+        Expects( size_in == 0 || ( size_in > 0 && data_in != NULL ) );
+    }
+
+    template< typename U >
+    gsl_api gsl_constexpr14 span( U * const & data_in, size_type size_in )
+        : begin_( data_in )
+        , limit_( make_limit( data_in, size_in ) )
+    {
+        Expects( size_in == 0 || ( size_in > 0 && data_in != NULL ) );
+    }
+
+    template< class U, size_t N >
+    gsl_api gsl_constexpr14 span( U (&arr)[N] )
+        : begin_( arr )
+        , limit_( make_limit( arr, N ) )
+    {}
+
+#if gsl_HAVE_ARRAY
+    template< class U, size_t N >
+    gsl_api gsl_constexpr14 span( std::array< U, N > & arr )
+        : begin_( arr.data() )
+        , limit_( make_limit( arr.data(), N ) )
+    {}
+#endif
+
+#if gsl_HAVE_DEFAULT_FUNCTION_TEMPLATE_ARG && gsl_HAVE_CONTAINER_DATA_METHOD
+# define gsl_HAVE_CONSTRAINED_SPAN_CONTAINER_CTOR   1
+#endif
+
+#if gsl_HAVE_CONSTRAINED_SPAN_CONTAINER_CTOR
+    // SFINAE enable only if Cont has a data() member function
+    template< class Cont, typename = decltype(std::declval<Cont>().data()) >
     gsl_api gsl_constexpr14 span( Cont & cont )
         : begin_( cont.data() )
-        , end_  ( cont.data() + cont.size() )
+        , limit_( make_limit( cont.data(), cont.size() ) )
     {}
 #elif gsl_HAVE_UNCONSTRAINED_SPAN_CONTAINER_CTOR
     template< class Cont >
     gsl_api gsl_constexpr14 span( Cont & cont )
         : begin_( cont.size() == 0 ? NULL : &cont[0] )
-        , end_  ( cont.size() == 0 ? NULL : &cont[0] + cont.size() )
+        , limit_( make_limit( cont.size() == 0 ? NULL : &cont[0], cont.size() ) )
     {}
 #endif
 
     template< class Cont >
     gsl_api gsl_constexpr14 span( with_container_t, Cont & cont )
         : begin_( cont.size() == 0 ? NULL : &cont[0] )
-        , end_  ( cont.size() == 0 ? NULL : &cont[0] + cont.size() )
+        , limit_( make_limit( cont.size() == 0 ? NULL : &cont[0], cont.size() ) )
     {}
 
 #if gsl_HAVE_IS_DEFAULT
@@ -1027,15 +1608,15 @@ public:
     gsl_api gsl_constexpr14 span( span const & ) = default;
 #else
     gsl_api gsl_constexpr14 span( span const & other )
-        : begin_( other.begin() )
-        , end_  ( other.end() )
+        : begin_( other.data() )
+        , limit_( make_limit( other.data(), other.size() ) )
     {}
 #endif
 
-    template< typename U >
-    gsl_api gsl_constexpr14 span( span<U> const & other )
-        : begin_( other.begin() )
-        , end_  ( other.end() )
+    template< typename U, size_t N >
+    gsl_api gsl_constexpr14 span( span<U, N> const & other )
+        : begin_( other.data() )
+        , limit_( make_limit( other.data(), other.size() ) )
     {}
 
 #if gsl_HAVE_IS_DEFAULT
@@ -1077,6 +1658,29 @@ public:
         Expects( offset <= this->size() && count <= this->size() - offset );
         return span( this->data() + offset, count ); 
     }
+
+    template< size_t Count >
+    gsl_api gsl_constexpr14 span<T, Count> first() const gsl_noexcept
+    {
+        Expects( Count <= this->size() );
+        return span<T, Count>( this->data(), Count );
+    }
+
+    template< size_t Count >
+    gsl_api gsl_constexpr14 span<T, Count> last() const gsl_noexcept
+    {
+        Expects( Count <= this->size() );
+
+        // clamped, so that no pointer before data() is formed where Expects() throws:
+        return span<T, Count>( this->data() + this->size() - ( Count < this->size() ? Count : this->size() ), Count );
+    }
+
+    template< size_t Offset, size_t Count >
+    gsl_api gsl_constexpr14 span<T, Count> subspan() const gsl_noexcept
+    {
+        Expects( Offset <= this->size() && Count <= this->size() - Offset );
+        return span<T, Count>( this->data() + Offset, Count );
+    }
 	
     gsl_api gsl_constexpr14 iterator begin() const gsl_noexcept
     {
@@ -1085,7 +1689,11 @@ public:
 
     gsl_api gsl_constexpr14 iterator end() const gsl_noexcept
     {
-        return iterator( end_ );
+#if gsl_CONFIG_SPAN_STORES_LENGTH
+        return iterator( begin_ + limit_ );
+#else
+        return iterator( limit_ );
+#endif
     }
 
     gsl_api gsl_constexpr14 const_iterator cbegin() const gsl_noexcept
@@ -1146,7 +1754,11 @@ public:
 
     gsl_api gsl_constexpr14 size_type size() const gsl_noexcept
     {
-        return end_ - begin_;
+#if gsl_CONFIG_SPAN_STORES_LENGTH
+        return limit_;
+#else
+        return limit_ - begin_;
+#endif
     }
 
     gsl_api gsl_constexpr14 size_type length() const gsl_noexcept
@@ -1173,7 +1785,7 @@ public:
     {
         using std::swap;
         swap( begin_, other.begin_ );
-        swap( end_  , other.end_   );
+        swap( limit_, other.limit_ );
     }
 
     gsl_api span< const byte > as_bytes() const gsl_noexcept
@@ -1194,159 +1806,5710 @@ public:
     }
 
 private:
-    pointer begin_;
-    pointer end_;
-};
+    // The span's end is stored either as a pointer or as a number of elements,
+    // see gsl_CONFIG_SPAN_STORES_LENGTH:
 
-// span comparison functions
+#if gsl_CONFIG_SPAN_STORES_LENGTH
+    typedef index_type limit_type;
 
-#if gsl_CONFIG_ALLOWS_NONSTRICT_SPAN_COMPARISON
+    gsl_api static gsl_constexpr limit_type make_limit( pointer, index_type size_in ) gsl_noexcept
+    {
+        return size_in;
+    }
 
-template< class T, class U >
-gsl_api gsl_constexpr14 bool operator==( span<T> const & l, span<U> const & r )
-{
-    return  l.size()  == r.size()
-        && (l.begin() == r.begin() || std::equal( l.begin(), l.end(), r.begin() ) );
-}
+    gsl_api static gsl_constexpr limit_type make_limit( pointer begin_in, pointer end_in ) gsl_noexcept
+    {
+        return static_cast<limit_type>( end_in - begin_in );
+    }
+#else
+    typedef pointer limit_type;
 
-template< class T, class U >
-gsl_api gsl_constexpr14 bool operator< ( span<T> const & l, span<U> const & r )
-{
-    return std::lexicographical_compare( l.begin(), l.end(), r.begin(), r.end() );
-}
+    gsl_api static gsl_constexpr limit_type make_limit( pointer data_in, index_type size_in ) gsl_noexcept
+    {
+        return data_in + size_in;
+    }
 
-#else
+    gsl_api static gsl_constexpr limit_type make_limit( pointer, pointer end_in ) gsl_noexcept
+    {
+        return end_in;
+    }
+#endif
 
-template< class T >
-gsl_api gsl_constexpr14 bool operator==( span<T> const & l, span<T> const & r )
-{
-    return  l.size()  == r.size()
-        && (l.begin() == r.begin() || std::equal( l.begin(), l.end(), r.begin() ) );
-}
+    // not checked: for the views, whose sub-spans lie within the span they
+    // checked on creation:
+
+    struct unchecked_t {};
+
+    gsl_api gsl_constexpr14 span( unchecked_t, pointer data_in, index_type size_in ) gsl_noexcept
+        : begin_( data_in )
+        , limit_( make_limit( data_in, size_in ) )
+    {}
+
+private:
+    pointer begin_;
+    limit_type limit_;
+};
 
 template< class T >
-gsl_api gsl_constexpr14 bool operator< ( span<T> const & l, span<T> const & r )
-{
-    return std::lexicographical_compare( l.begin(), l.end(), r.begin(), r.end() );
-}
-#endif
+const typename span< T, dynamic_extent >::index_type span< T, dynamic_extent >::extent;
 
-template< class T, class U >
-gsl_api gsl_constexpr14 bool operator!=( span<T> const & l, span<U> const & r )
+//
+// span<T, N> - A 1D view of N contiguous T's, with N known at compile time.
+//
+// Only stores a pointer: size() is a constant, slicing via first<Count>(),
+// last<Count>() and subspan<Offset, Count>() is checked at compile time.
+// Converts implicitly to the dynamic-extent span<T>.
+//
+template< class T, size_t Extent >
+class span
 {
-    return !( l == r );
-}
+    template< class U, size_t N > friend class span;
 
-template< class T, class U >
-gsl_api gsl_constexpr14 bool operator<=( span<T> const & l, span<U> const & r )
-{
-    return !( r < l );
-}
+public:
+    typedef size_t index_type;
 
-template< class T, class U >
-gsl_api gsl_constexpr14 bool operator> ( span<T> const & l, span<U> const & r )
-{
-    return ( r < l );
-}
+    typedef T element_type;
+    typedef T & reference;
+    typedef T * pointer;
+    typedef T const * const_pointer;
+    typedef T const & const_reference;
 
-template< class T, class U >
-gsl_api gsl_constexpr14 bool operator>=( span<T> const & l, span<U> const & r )
-{
-    return !( l < r );
-}
+    typedef pointer       iterator;
+    typedef const_pointer const_iterator;
 
-// span algorithms
+#if gsl_BETWEEN( gsl_COMPILER_MSVC_VERSION, 6, 7 )
+    typedef std::reverse_iterator< iterator, T >             reverse_iterator;
+    typedef std::reverse_iterator< const_iterator, const T > const_reverse_iterator;
+#else
+    typedef std::reverse_iterator< iterator >                reverse_iterator;
+    typedef std::reverse_iterator< const_iterator >          const_reverse_iterator;
+#endif
 
-namespace detail {
+    typedef typename std::iterator_traits< iterator >::difference_type difference_type;
 
-template< class II, class N, class OI >
-OI copy_n( II first, N count, OI result )
-{
-    if ( count > 0 ) 
+    static const index_type extent = Extent;
+
+    gsl_api gsl_constexpr14 span( pointer begin_in, pointer end_in )
+        : data_( begin_in )
     {
-        *result++ = *first;
-        for ( N i = 1; i < count; ++i ) 
-        {
-            *result++ = *++first;
-        }
+        Expects( begin_in <= end_in && index_type( end_in - begin_in ) == Extent );
     }
-    return result;
-}
-}
 
-template< class T, class U >
-void copy( span<T> src, span<U> dest )
-{
-#if gsl_CPP14_OR_GREATER // gsl_HAVE_TYPE_TRAITS (circumvent Travis clang 3.4)
-    static_assert( std::is_assignable<U &, T const &>::value, "Cannot assign elements of source span to elements of destination span" );
+    gsl_api gsl_constexpr14 span( pointer data_in, index_type size_in )
+        : data_( data_in )
+    {
+        Expects( size_in == Extent && ( Extent == 0 || data_in != NULL ) );
+    }
+
+    template< class U >
+    gsl_api gsl_constexpr14 span( U (&arr)[Extent] )
+        : data_( arr )
+    {}
+
+#if gsl_HAVE_ARRAY
+    template< class U >
+    gsl_api gsl_constexpr14 span( std::array< U, Extent > & arr )
+        : data_( arr.data() )
+    {}
+
+    template< class U >
+    gsl_api gsl_constexpr14 span( std::array< U, Extent > const & arr )
+        : data_( arr.data() )
+    {}
 #endif
-    Expects( dest.size() >= src.size() );
-    detail::copy_n( src.data(), src.size(), dest.data() );
+
+    template< class U >
+    gsl_api gsl_constexpr14 span( span<U, Extent> const & other )
+        : data_( other.data() )
+    {}
+
+    template< class U >
+    gsl_api gsl_constexpr14 gsl_explicit span( span<U> const & other )
+        : data_( other.data() )
+    {
+        Expects( other.size() == Extent );
+    }
+
+    template< size_t Count >
+    gsl_api gsl_constexpr14 span<T, Count> first() const gsl_noexcept
+    {
+        gsl_STATIC_ASSERT( Count <= Extent, "span<T, N>::first<Count>(): Count exceeds N" );
+        return span<T, Count>( data_, Count );
+    }
+
+    template< size_t Count >
+    gsl_api gsl_constexpr14 span<T, Count> last() const gsl_noexcept
+    {
+        gsl_STATIC_ASSERT( Count <= Extent, "span<T, N>::last<Count>(): Count exceeds N" );
+        return span<T, Count>( data_ + ( Extent - Count ), Count );
+    }
+
+#if gsl_HAVE_DEFAULT_FUNCTION_TEMPLATE_ARG
+    template< size_t Offset, size_t Count = Extent - Offset >
+#else
+    template< size_t Offset, size_t Count >
+#endif
+    gsl_api gsl_constexpr14 span<T, Count> subspan() const gsl_noexcept
+    {
+        gsl_STATIC_ASSERT( Offset <= Extent && Count <= Extent - Offset, "span<T, N>::subspan<Offset, Count>(): range exceeds N" );
+        return span<T, Count>( data_ + Offset, Count );
+    }
+
+    gsl_api gsl_constexpr14 span<T> first( index_type count ) const gsl_noexcept
+    {
+        return span<T>( *this ).first( count );
+    }
+
+    gsl_api gsl_constexpr14 span<T> last( index_type count ) const gsl_noexcept
+    {
+        return span<T>( *this ).last( count );
+    }
+
+    gsl_api gsl_constexpr14 span<T> subspan( index_type offset ) const gsl_noexcept
+    {
+        return span<T>( *this ).subspan( offset );
+    }
+
+    gsl_api gsl_constexpr14 span<T> subspan( index_type offset, index_type count ) const gsl_noexcept
+    {
+        return span<T>( *this ).subspan( offset, count );
+    }
+
+    gsl_api gsl_constexpr14 iterator begin() const gsl_noexcept
+    {
+        return iterator( data_ );
+    }
+
+    gsl_api gsl_constexpr14 iterator end() const gsl_noexcept
+    {
+        return iterator( data_ + Extent );
+    }
+
+    gsl_api gsl_constexpr14 const_iterator cbegin() const gsl_noexcept
+    {
+        return const_iterator( begin() );
+    }
+
+    gsl_api gsl_constexpr14 const_iterator cend() const gsl_noexcept
+    {
+        return const_iterator( end() );
+    }
+
+    gsl_api gsl_constexpr14 reverse_iterator rbegin() const gsl_noexcept
+    {
+        return reverse_iterator( end() );
+    }
+
+    gsl_api gsl_constexpr14 reverse_iterator rend() const gsl_noexcept
+    {
+        return reverse_iterator( begin() );
+    }
+
+    gsl_api gsl_constexpr14 const_reverse_iterator crbegin() const gsl_noexcept
+    {
+        return const_reverse_iterator( cend() );
+    }
+
+    gsl_api gsl_constexpr14 const_reverse_iterator crend() const gsl_noexcept
+    {
+        return const_reverse_iterator( cbegin() );
+    }
+
+    gsl_api gsl_constexpr14 reference operator[]( index_type index ) const
+    {
+       return at( index );
+    }
+
+    gsl_api gsl_constexpr14 reference operator()( index_type index ) const
+    {
+       return at( index );
+    }
+
+    gsl_api gsl_constexpr14 reference at( index_type index ) const
+    {
+       Expects( index < Extent );
+       return data_[ index ];
+    }
+
+    gsl_api gsl_constexpr14 pointer data() const gsl_noexcept
+    {
+        return data_;
+    }
+
+    gsl_api gsl_constexpr bool empty() const gsl_noexcept
+    {
+        return Extent == 0;
+    }
+
+    gsl_api gsl_constexpr index_type size() const gsl_noexcept
+    {
+        return Extent;
+    }
+
+    gsl_api gsl_constexpr index_type length() const gsl_noexcept
+    {
+        return Extent;
+    }
+
+    gsl_api gsl_constexpr index_type used_length() const gsl_noexcept
+    {
+        return Extent;
+    }
+
+    gsl_api gsl_constexpr index_type bytes() const gsl_noexcept
+    {
+        return sizeof( element_type ) * Extent;
+    }
+
+    gsl_api gsl_constexpr index_type used_bytes() const gsl_noexcept
+    {
+        return sizeof( element_type ) * Extent;
+    }
+
+    gsl_api void swap( span & other ) gsl_noexcept
+    {
+        using std::swap;
+        swap( data_, other.data_ );
+    }
+
+    gsl_api span< const byte, Extent * sizeof( T ) > as_bytes() const gsl_noexcept
+    {
+        return span< const byte, Extent * sizeof( T ) >( reinterpret_cast<const byte *>( data_ ), Extent * sizeof( T ) );
+    }
+
+    gsl_api span< byte, Extent * sizeof( T ) > as_writeable_bytes() const gsl_noexcept
+    {
+        return span< byte, Extent * sizeof( T ) >( reinterpret_cast<byte *>( data_ ), Extent * sizeof( T ) );
+    }
+
+    template< typename U >
+    gsl_api span< U > as_span() const gsl_noexcept
+    {
+        return span<T>( *this ).template as_span<U>();
+    }
+
+private:
+    pointer data_;
+};
+
+template< class T, size_t Extent >
+const typename span< T, Extent >::index_type span< T, Extent >::extent;
+
+// span comparison functions
+//
+// Elements of the same type with a unique object representation, such as
+// integers, characters and byte, are compared bytewise via std::memcmp()
+// and, with SSE2, 16 bytes at a time to find the first difference.
+
+namespace detail {
+
+// number of equal leading bytes of a and b, at most count:
+
+inline size_t mismatch_bytes( unsigned char const * a, unsigned char const * b, size_t count )
+{
+    size_t i = 0;
+#if gsl_HAVE_SSE2
+    for ( ; i + 16 <= count; i += 16 )
+    {
+        __m128i const x = _mm_loadu_si128( reinterpret_cast<__m128i const *>( a + i ) );
+        __m128i const y = _mm_loadu_si128( reinterpret_cast<__m128i const *>( b + i ) );
+        unsigned const differ = 0xFFFFu ^ static_cast<unsigned>( _mm_movemask_epi8( _mm_cmpeq_epi8( x, y ) ) );
+
+        if ( differ != 0 )
+            return i + count_trailing_zeros( differ );
+    }
+#endif
+    for ( ; i < count && a[i] == b[i]; ++i )
+    {}
+    return i;
+}
+
+template< class T, class U >
+bool equal_n( T * l, U * r, size_t count, false_type )
+{
+    return std::equal( l, l + count, r );
+}
+
+template< class T, class U >
+bool equal_n( T * l, U * r, size_t count, true_type )
+{
+    return count == 0 || 0 == std::memcmp( l, r, count * sizeof( T ) );
+}
+
+template< class T, class U >
+size_t mismatch_n( T * l, U * r, size_t count, false_type )
+{
+    size_t i = 0;
+    for ( ; i < count && l[i] == r[i]; ++i )
+    {}
+    return i;
+}
+
+template< class T, class U >
+size_t mismatch_n( T * l, U * r, size_t count, true_type )
+{
+    return mismatch_bytes( reinterpret_cast<unsigned char const *>( l ), reinterpret_cast<unsigned char const *>( r ), count * sizeof( T ) ) / sizeof( T );
+}
+
+template< class T, size_t N, class U, size_t M >
+bool equal( span<T, N> const & l, span<U, M> const & r )
+{
+    return  l.size()  == r.size()
+        && ( l.data() == r.data() || equal_n( l.data(), r.data(), l.size(), is_bytewise_comparable<T, U>() ) );
+}
+
+template< class T, size_t N, class U, size_t M >
+bool less( span<T, N> const & l, span<U, M> const & r )
+{
+    size_t const count = l.size() < r.size() ? l.size() : r.size();
+    size_t const index = mismatch_n( l.data(), r.data(), count, is_bytewise_comparable<T, U>() );
+
+    return index == count ? l.size() < r.size() : l.data()[ index ] < r.data()[ index ];
+}
+} // namespace detail
+
+#if gsl_CONFIG_ALLOWS_NONSTRICT_SPAN_COMPARISON
+
+template< class T, size_t N, class U, size_t M >
+gsl_api gsl_constexpr14 bool operator==( span<T, N> const & l, span<U, M> const & r )
+{
+    return detail::equal( l, r );
+}
+
+template< class T, size_t N, class U, size_t M >
+gsl_api gsl_constexpr14 bool operator< ( span<T, N> const & l, span<U, M> const & r )
+{
+    return detail::less( l, r );
+}
+
+#else
+
+template< class T, size_t N, size_t M >
+gsl_api gsl_constexpr14 bool operator==( span<T, N> const & l, span<T, M> const & r )
+{
+    return detail::equal( l, r );
+}
+
+template< class T, size_t N, size_t M >
+gsl_api gsl_constexpr14 bool operator< ( span<T, N> const & l, span<T, M> const & r )
+{
+    return detail::less( l, r );
+}
+#endif
+
+template< class T, size_t N, class U, size_t M >
+gsl_api gsl_constexpr14 bool operator!=( span<T, N> const & l, span<U, M> const & r )
+{
+    return !( l == r );
+}
+
+template< class T, size_t N, class U, size_t M >
+gsl_api gsl_constexpr14 bool operator<=( span<T, N> const & l, span<U, M> const & r )
+{
+    return !( r < l );
+}
+
+template< class T, size_t N, class U, size_t M >
+gsl_api gsl_constexpr14 bool operator> ( span<T, N> const & l, span<U, M> const & r )
+{
+    return ( r < l );
+}
+
+template< class T, size_t N, class U, size_t M >
+gsl_api gsl_constexpr14 bool operator>=( span<T, N> const & l, span<U, M> const & r )
+{
+    return !( l < r );
+}
+
+// mismatch(): index of the first element that differs between l and r,
+// or the size of the shorter span if one is a prefix of the other.
+
+template< class T, size_t N, class U, size_t M >
+size_t mismatch( span<T, N> const & l, span<U, M> const & r )
+{
+    size_t const count = l.size() < r.size() ? l.size() : r.size();
+    return detail::mismatch_n( l.data(), r.data(), count, detail::is_bytewise_comparable<T, U>() );
+}
+
+// span search
+//
+// Elements of 1, 2 or 4 bytes with a unique object representation, such as
+// integers, characters and byte, are compared a SIMD vector at a time with
+// SSE2 or AVX2, like memchr().
+
+namespace detail {
+
+// elements of span<T> that are compared to elements of U a SIMD vector at a time:
+
+template< class T, class U >
+struct is_simd_search
+#if gsl_HAVE_SSE2
+    : bool_constant< is_simd_searchable<T>::value && is_bytewise_comparable<T, U>::value > {};
+#else
+    : false_type {};
+#endif
+
+template< class T, class V >
+size_t find_n( T * s, size_t n, V const & value, false_type )
+{
+    size_t i = 0;
+    for ( ; i < n && !( s[i] == value ); ++i )
+    {}
+    return i;
+}
+
+template< class T, class V >
+size_t count_n( T * s, size_t n, V const & value, false_type )
+{
+    size_t result = 0;
+    for ( size_t i = 0; i < n; ++i )
+    {
+        if ( s[i] == value )
+            ++result;
+    }
+    return result;
+}
+
+template< class T, class U >
+size_t find_any_n( T * s, size_t n, U * values, size_t m, false_type )
+{
+    for ( size_t i = 0; i < n; ++i )
+    {
+        for ( size_t k = 0; k < m; ++k )
+        {
+            if ( s[i] == values[k] )
+                return i;
+        }
+    }
+    return n;
+}
+
+#if gsl_HAVE_SSE2
+
+// Whole vectors are loaded unaligned, four at a time while they fit; the last
+// vector overlaps the one before it when n is not a multiple of the vector
+// size. Spans shorter than a vector are searched an element at a time.
+
+template< class T, class V >
+size_t find_n( T * s, size_t n, V const & value, true_type )
+{
+    typedef simd_lanes< sizeof( T ) > lanes;
+    size_t const lane_count = simd_width / sizeof( T );
+
+    if ( n < lane_count )
+        return find_n( s, n, value, false_type() );
+
+    char const * const p = reinterpret_cast<char const *>( s );
+    simd_vector const needle = lanes::splat( value );
+
+    size_t i = 0;
+    for ( ; i + 4 * lane_count <= n; i += 4 * lane_count )
+    {
+        char const * const q = p + i * sizeof( T );
+
+        simd_vector const a = lanes::equal( simd_loadu( q                  ), needle );
+        simd_vector const b = lanes::equal( simd_loadu( q +     simd_width ), needle );
+        simd_vector const c = lanes::equal( simd_loadu( q + 2 * simd_width ), needle );
+        simd_vector const d = lanes::equal( simd_loadu( q + 3 * simd_width ), needle );
+
+        if ( simd_mask( simd_or( simd_or( a, b ), simd_or( c, d ) ) ) != 0 )
+            break;
+    }
+    for ( ; ; i += lane_count )
+    {
+        i = (std::min)( i, n - lane_count );
+
+        unsigned const mask = simd_mask( lanes::equal( simd_loadu( p + i * sizeof( T ) ), needle ) );
+
+        if ( mask != 0 )
+            return i + count_trailing_zeros( mask ) / sizeof( T );
+        if ( i == n - lane_count )
+            return n;
+    }
+}
+
+// sum of the lanes of v as unsigned integers of type L:
+
+template< class L >
+size_t simd_sum( simd_vector v )
+{
+    L lanes[ simd_width / sizeof( L ) ];
+    std::memcpy( lanes, &v, sizeof( v ) );
+
+    size_t sum = 0;
+    for ( size_t k = 0; k < simd_width / sizeof( L ); ++k )
+        sum += lanes[k];
+    return sum;
 }
 
-// span creator functions (see ctors)
+// Every lane counts its matches, as equal() yields -1 per match, until the
+// lanes could overflow; then the lanes are added up.
+
+template< class T, class V >
+size_t count_n( T * s, size_t n, V const & value, true_type )
+{
+    typedef simd_lanes< sizeof( T ) > lanes;
+    typedef typename uint_of_size< sizeof( T ) >::type lane;
+    size_t const lane_count = simd_width / sizeof( T );
+    size_t const max_rounds = static_cast<size_t>( lane( -1 ) );
+
+    char const * const p = reinterpret_cast<char const *>( s );
+    simd_vector const needle = lanes::splat( value );
+
+    size_t result = 0;
+    size_t i = 0;
+    while ( i + lane_count <= n )
+    {
+        simd_vector counts = lanes::splat( lane( 0 ) );
+
+        for ( size_t round = 0; round < max_rounds && i + lane_count <= n; ++round, i += lane_count )
+            counts = lanes::sub( counts, lanes::equal( simd_loadu( p + i * sizeof( T ) ), needle ) );
+
+        result += simd_sum<lane>( counts );
+    }
+    return result + count_n( s + i, n - i, value, false_type() );
+}
+
+// up to 4 values at a time, the search for the next values stops at the best
+// index found so far:
+
+template< class T, class U >
+size_t find_any_n( T * s, size_t n, U * values, size_t m, true_type )
+{
+    typedef simd_lanes< sizeof( T ) > lanes;
+    size_t const lane_count = simd_width / sizeof( T );
+
+    if ( n < lane_count )
+        return find_any_n( s, n, values, m, false_type() );
+
+    char const * const p = reinterpret_cast<char const *>( s );
+
+    for ( size_t k = 0; k < m && n >= lane_count; k += 4 )
+    {
+        size_t const needle_count = (std::min)( m - k, size_t( 4 ) );
+        simd_vector needles[4];
+
+        for ( size_t j = 0; j < needle_count; ++j )
+            needles[j] = lanes::splat( values[ k + j ] );
+
+        for ( size_t i = 0; ; i += lane_count )
+        {
+            i = (std::min)( i, n - lane_count );
+
+            simd_vector const v = simd_loadu( p + i * sizeof( T ) );
+            unsigned mask = 0;
+
+            for ( size_t j = 0; j < needle_count; ++j )
+                mask |= simd_mask( lanes::equal( v, needles[j] ) );
+
+            if ( mask != 0 )
+            {
+                n = i + count_trailing_zeros( mask ) / sizeof( T );
+                break;
+            }
+            if ( i == n - lane_count )
+                break;
+        }
+    }
+    return n < lane_count ? find_any_n( s, n, values, m, false_type() ) : n;
+}
+
+#endif // gsl_HAVE_SSE2
+} // namespace detail
+
+// find(): index of the first element of s equal to value, or s.size():
+// the result composes with subspan().
+
+template< class T, size_t N >
+size_t find( span<T, N> const & s, typename detail::remove_cv<T>::type const & value )
+{
+    return detail::find_n( s.data(), s.size(), value, detail::is_simd_search<T, T>() );
+}
+
+// find_if_equal_any(): index of the first element of s equal to any element
+// of values, or s.size().
+
+template< class T, size_t N, class U, size_t M >
+size_t find_if_equal_any( span<T, N> const & s, span<U, M> const & values )
+{
+    return detail::find_any_n( s.data(), s.size(), values.data(), values.size(), detail::is_simd_search<T, U>() );
+}
+
+// count(): number of elements of s equal to value.
+
+template< class T, size_t N >
+size_t count( span<T, N> const & s, typename detail::remove_cv<T>::type const & value )
+{
+    return detail::count_n( s.data(), s.size(), value, detail::is_simd_search<T, T>() );
+}
+
+// contains(): whether an element of s is equal to value.
+
+template< class T, size_t N >
+bool contains( span<T, N> const & s, typename detail::remove_cv<T>::type const & value )
+{
+    return find( s, value ) != s.size();
+}
+
+// substring search
+//
+// Elements of one byte, such as char and byte, are searched via the first and
+// the last element of the needle: with SSE2 a SIMD vector of candidate
+// positions at a time, each candidate verified with std::memcmp(); without
+// SSE2 via Horspool's algorithm. Nothing is allocated.
+
+namespace detail {
+
+// elements of span<T> that are compared to elements of U as single bytes:
+
+template< class T, class U >
+struct is_byte_search : bool_constant< sizeof( T ) == 1 && is_bytewise_comparable<T, U>::value > {};
+
+// offset of the first or the last occurrence of needle[0..m) in h[0..n), or n;
+// 0 < m <= n:
+
+template< class T, class U >
+size_t search_n( T * h, size_t n, U * needle, size_t m, false_type )
+{
+    for ( size_t i = 0; i + m <= n; ++i )
+    {
+        if ( std::equal( needle, needle + m, h + i ) )
+            return i;
+    }
+    return n;
+}
+
+template< class T, class U >
+size_t rsearch_n( T * h, size_t n, U * needle, size_t m, false_type )
+{
+    for ( size_t i = n - m + 1; i-- > 0; )
+    {
+        if ( std::equal( needle, needle + m, h + i ) )
+            return i;
+    }
+    return n;
+}
+
+#if gsl_HAVE_SSE2
+
+// Candidates are the positions where both the first and the last byte of the
+// needle match; the positions too close to the end for a whole vector are
+// searched as above.
+
+inline size_t search_bytes( unsigned char const * h, size_t n, unsigned char const * needle, size_t m )
+{
+    if ( m == 1 )
+        return find_n( h, n, needle[0], true_type() );
+
+    typedef simd_lanes<1> lanes;
+
+    simd_vector const first = lanes::splat( needle[0] );
+    simd_vector const last  = lanes::splat( needle[ m - 1 ] );
+
+    size_t i = 0;
+    for ( ; i + simd_width + m - 1 <= n; i += simd_width )
+    {
+        char const * const p = reinterpret_cast<char const *>( h + i );
+
+        unsigned mask = simd_mask( lanes::equal( simd_loadu( p         ), first ) )
+                      & simd_mask( lanes::equal( simd_loadu( p + m - 1 ), last  ) );
+
+        for ( ; mask != 0; mask &= mask - 1 )
+        {
+            size_t const k = i + count_trailing_zeros( mask );
+
+            if ( 0 == std::memcmp( h + k + 1, needle + 1, m - 2 ) )
+                return k;
+        }
+    }
+    return i + search_n( h + i, n - i, needle, m, false_type() );
+}
+
+// as above, a vector of candidate positions at a time from the end:
+
+inline size_t rsearch_bytes( unsigned char const * h, size_t n, unsigned char const * needle, size_t m )
+{
+    typedef simd_lanes<1> lanes;
+
+    simd_vector const first = lanes::splat( needle[0] );
+    simd_vector const last  = lanes::splat( needle[ m - 1 ] );
+
+    size_t end = n - m + 1;
+    for ( ; end >= size_t( simd_width ); end -= simd_width )
+    {
+        char const * const p = reinterpret_cast<char const *>( h + end - simd_width );
+
+        unsigned mask = simd_mask( lanes::equal( simd_loadu( p         ), first ) )
+                      & simd_mask( lanes::equal( simd_loadu( p + m - 1 ), last  ) );
+
+        size_t found = n;
+        for ( ; mask != 0; mask &= mask - 1 )
+        {
+            size_t const k = end - simd_width + count_trailing_zeros( mask );
+
+            if ( m < 2 || 0 == std::memcmp( h + k + 1, needle + 1, m - 2 ) )
+                found = k;
+        }
+        if ( found != n )
+            return found;
+    }
+    size_t const rest = end + m - 1;
+    size_t const k = rsearch_n( h, rest, needle, m, false_type() );
+    return k == rest ? n : k;
+}
+
+#else // gsl_HAVE_SSE2
+
+// Horspool: shift by the distance of the last byte of the window to its last
+// occurrence in the needle before the needle's last byte.
+
+inline size_t search_bytes( unsigned char const * h, size_t n, unsigned char const * needle, size_t m )
+{
+    size_t shift[256];
+
+    for ( size_t k = 0; k < 256; ++k )
+        shift[k] = m;
+    for ( size_t k = 0; k + 1 < m; ++k )
+        shift[ needle[k] ] = m - 1 - k;
+
+    for ( size_t i = 0; i + m <= n; i += shift[ h[ i + m - 1 ] ] )
+    {
+        if ( h[ i + m - 1 ] == needle[ m - 1 ] && 0 == std::memcmp( h + i, needle, m - 1 ) )
+            return i;
+    }
+    return n;
+}
+
+inline size_t rsearch_bytes( unsigned char const * h, size_t n, unsigned char const * needle, size_t m )
+{
+    return rsearch_n( h, n, needle, m, false_type() );
+}
+
+#endif // gsl_HAVE_SSE2
+
+template< class T, class U >
+size_t search_n( T * h, size_t n, U * needle, size_t m, true_type )
+{
+    return search_bytes( reinterpret_cast<unsigned char const *>( h ), n, reinterpret_cast<unsigned char const *>( needle ), m );
+}
+
+template< class T, class U >
+size_t rsearch_n( T * h, size_t n, U * needle, size_t m, true_type )
+{
+    return rsearch_bytes( reinterpret_cast<unsigned char const *>( h ), n, reinterpret_cast<unsigned char const *>( needle ), m );
+}
+} // namespace detail
+
+// find(): offset of the first occurrence of needle in haystack, or
+// haystack.size(); an empty needle occurs at offset 0.
+
+template< class T, size_t N, class U, size_t M >
+size_t find( span<T, N> const & haystack, span<U, M> const & needle )
+{
+    if ( needle.empty() || needle.size() > haystack.size() )
+        return needle.empty() ? 0 : haystack.size();
+
+    return detail::search_n( haystack.data(), haystack.size(), needle.data(), needle.size(), detail::is_byte_search<T, U>() );
+}
+
+// rfind(): offset of the last occurrence of needle in haystack, or
+// haystack.size(); an empty needle occurs at offset haystack.size().
+
+template< class T, size_t N, class U, size_t M >
+size_t rfind( span<T, N> const & haystack, span<U, M> const & needle )
+{
+    if ( needle.empty() || needle.size() > haystack.size() )
+        return haystack.size();
+
+    return detail::rsearch_n( haystack.data(), haystack.size(), needle.data(), needle.size(), detail::is_byte_search<T, U>() );
+}
+
+// find_all(): call f( offset ) for each occurrence of needle in haystack from
+// left to right, occurrences do not overlap; return the number of occurrences.
+
+template< class T, size_t N, class U, size_t M, class F >
+size_t find_all( span<T, N> const & haystack, span<U, M> const & needle, F f )
+{
+    Expects( ! needle.empty() );
+
+    size_t const n = haystack.size();
+    size_t const m = needle.size();
+    size_t occurrences = 0;
+
+    for ( size_t from = 0; from + m <= n; ++occurrences )
+    {
+        size_t const offset = from + detail::search_n( haystack.data() + from, n - from, needle.data(), m, detail::is_byte_search<T, U>() );
+
+        if ( offset == n )
+            break;
+
+        f( offset );
+        from = offset + m;
+    }
+    return occurrences;
+}
+
+// span algorithms
+
+namespace detail {
+
+template< class II, class N, class OI >
+OI copy_n( II first, N count, OI result )
+{
+    if ( count > 0 ) 
+    {
+        *result++ = *first;
+        for ( N i = 1; i < count; ++i ) 
+        {
+            *result++ = *++first;
+        }
+    }
+    return result;
+}
+
+#if gsl_HAVE_SSE2 && gsl_CONFIG_NONTEMPORAL_COPY_THRESHOLD > 0
+
+// copy bypassing the cache via non-temporal stores; src and dest must not overlap:
+
+inline void stream_bytes( char * dest, char const * src, size_t count )
+{
+    size_t const head = ( 16 - ( reinterpret_cast<size_t>( dest ) & 15 ) ) & 15;
+
+    std::memcpy( dest, src, head );
+    dest += head; src += head; count -= head;
+
+    for ( ; count >= 64; count -= 64, dest += 64, src += 64 )
+    {
+        __m128i const a = _mm_loadu_si128( reinterpret_cast<__m128i const *>( src      ) );
+        __m128i const b = _mm_loadu_si128( reinterpret_cast<__m128i const *>( src + 16 ) );
+        __m128i const c = _mm_loadu_si128( reinterpret_cast<__m128i const *>( src + 32 ) );
+        __m128i const d = _mm_loadu_si128( reinterpret_cast<__m128i const *>( src + 48 ) );
+        _mm_stream_si128( reinterpret_cast<__m128i *>( dest      ), a );
+        _mm_stream_si128( reinterpret_cast<__m128i *>( dest + 16 ), b );
+        _mm_stream_si128( reinterpret_cast<__m128i *>( dest + 32 ), c );
+        _mm_stream_si128( reinterpret_cast<__m128i *>( dest + 48 ), d );
+    }
+    _mm_sfence();
+
+    std::memcpy( dest, src, count );
+}
+#endif
+
+inline void move_bytes( void * dest, void const * src, size_t count )
+{
+#if gsl_HAVE_SSE2 && gsl_CONFIG_NONTEMPORAL_COPY_THRESHOLD > 0
+    char       * const d = static_cast<char       *>( dest );
+    char const * const s = static_cast<char const *>( src  );
+
+    if ( count >= gsl_CONFIG_NONTEMPORAL_COPY_THRESHOLD && count >= 128 && ( d + count <= s || s + count <= d ) )
+    {
+        stream_bytes( d, s, count );
+        return;
+    }
+#endif
+    std::memmove( dest, src, count );
+}
+
+template< class T, class U >
+void copy_span( T * src, size_t count, U * dest, false_type )
+{
+    detail::copy_n( src, count, dest );
+}
+
+template< class T, class U >
+void copy_span( T * src, size_t count, U * dest, true_type )
+{
+    if ( count > 0 )
+        move_bytes( dest, src, count * sizeof( U ) );
+}
+}
+
+// copy(): copy the elements of src to the start of dest.
+//
+// For elements of the same trivially copyable type, copy() copies bytes as
+// std::memmove() does, so that src and dest may overlap. Otherwise elements are
+// assigned front to back and dest must not start within src.
+// See also gsl_CONFIG_NONTEMPORAL_COPY_THRESHOLD.
+
+template< class T, size_t N, class U, size_t M >
+void copy( span<T, N> src, span<U, M> dest )
+{
+#if gsl_CPP14_OR_GREATER // gsl_HAVE_TYPE_TRAITS (circumvent Travis clang 3.4)
+    static_assert( std::is_assignable<U &, T const &>::value, "Cannot assign elements of source span to elements of destination span" );
+#endif
+    Expects( dest.size() >= src.size() );
+    detail::copy_span( src.data(), src.size(), dest.data(), detail::is_bytewise_copyable<T, U>() );
+}
+
+// span creator functions (see ctors)
+
+template< typename T >
+gsl_api gsl_constexpr14 span<T> as_span( T * begin, T * end )
+{
+    return span<T>( begin, end );
+}
+
+template< typename T >
+gsl_api gsl_constexpr14 span<T> as_span( T * begin, size_t size )
+{
+    return span<T>( begin, size );
+}
+
+template< typename T, size_t N >
+gsl_api gsl_constexpr14 span<T> as_span( T (&arr)[N] )
+{
+    return span<T>( arr, N );
+}
+
+#if gsl_HAVE_ARRAY
+
+template< typename T, size_t N >
+gsl_api gsl_constexpr14 span<T> as_span( std::array<T,N> & arr )
+{
+    return span<T>( arr );
+}
+
+template< typename T, size_t N >
+gsl_api gsl_constexpr14 span<const T> as_span( std::array<T,N> const & arr )
+{
+    return span<const T>( arr );
+}
+#endif
+
+#if gsl_HAVE_CONSTRAINED_SPAN_CONTAINER_CTOR && gsl_HAVE_AUTO
+
+template< class Cont >
+gsl_api gsl_constexpr14 auto as_span( Cont & cont ) -> span< typename Cont::value_type >
+{
+    return span< typename Cont::value_type >( cont );
+}
+
+template< class Cont >
+gsl_api gsl_constexpr14 auto as_span( Cont const & cont ) -> span< const typename Cont::value_type >
+{
+    return span< const typename Cont::value_type >( cont );
+}
+
+#else
+
+template< class T >
+gsl_api span<T> as_span( std::vector<T> & cont )
+{
+    return span<T>( with_container, cont );
+}
+
+template< class T >
+gsl_api span<const T> as_span( std::vector<T> const & cont )
+{
+    return span<const T>( with_container, cont );
+}
+#endif
+
+//
+// checked_range<> - Elements [first, last) of a span; bounds are checked once.
+//
+// The range is checked on creation, so that a loop can iterate or index
+// within it without a contract check per element:
+//
+//     for ( T & x : as_checked_range( s, lo, hi ) ) ...
+//
+//     checked_range<T> r = as_checked_range( s, lo, hi );
+//     for ( size_t i = 0; i < r.size(); ++i ) ... r[i] ...
+//
+template< class T >
+class checked_range
+{
+public:
+    typedef size_t index_type;
+
+    typedef T element_type;
+    typedef T & reference;
+    typedef T * pointer;
+
+    typedef pointer iterator;
+
+    gsl_api gsl_constexpr14 explicit checked_range( span<T> s ) gsl_noexcept
+        : first_( s.data() )
+        , last_ ( s.data() + s.size() )
+    {}
+
+    gsl_api gsl_constexpr14 checked_range( span<T> s, index_type first, index_type last )
+        : first_( checked_first( s, first, last ) )
+        , last_ ( s.data() + last )
+    {}
+
+    gsl_api gsl_constexpr14 iterator begin() const gsl_noexcept
+    {
+        return first_;
+    }
+
+    gsl_api gsl_constexpr14 iterator end() const gsl_noexcept
+    {
+        return last_;
+    }
+
+    // not checked: index is relative to begin() and must be below size()
+    gsl_api gsl_constexpr14 reference operator[]( index_type index ) const gsl_noexcept
+    {
+        return first_[ index ];
+    }
+
+    gsl_api gsl_constexpr14 pointer data() const gsl_noexcept
+    {
+        return first_;
+    }
+
+    gsl_api gsl_constexpr14 index_type size() const gsl_noexcept
+    {
+        return static_cast<index_type>( last_ - first_ );
+    }
+
+    gsl_api gsl_constexpr14 bool empty() const gsl_noexcept
+    {
+        return first_ == last_;
+    }
+
+    gsl_api gsl_constexpr14 span<T> as_span() const gsl_noexcept
+    {
+        return span<T>( first_, last_ );
+    }
+
+private:
+    // the range is checked before any pointer into it is formed:
+
+    gsl_api static gsl_constexpr14 pointer checked_first( span<T> s, index_type first, index_type last )
+    {
+        Expects( first <= last && last <= s.size() );
+        return s.data() + first;
+    }
+
+    pointer first_;
+    pointer last_;
+};
+
+template< class T, size_t N >
+gsl_api gsl_constexpr14 checked_range<T> as_checked_range( span<T, N> s )
+{
+    return checked_range<T>( s );
+}
+
+template< class T, size_t N >
+gsl_api gsl_constexpr14 checked_range<T> as_checked_range( span<T, N> s, size_t first, size_t last )
+{
+    return checked_range<T>( s, first, last );
+}
+
+//
+// chunk_view<>, window_view<>, aligned_chunk_view<> - Views of a span as a
+// sequence of sub-spans, made on access without allocation. The view is
+// checked on creation, its sub-spans are not checked again:
+//
+//     for ( span<float> batch : chunks( samples, 256 ) ) ...       // the last one may be shorter
+//     for ( span<float> w : windows( signal, 64, 16 ) ) ...        // 64 elements, starting every 16
+//
+//     aligned_chunk_view<float> v = aligned_chunks( samples, 32 ); // chunks of 32 aligned bytes
+//     scalar( v.head() );
+//     for ( span<float> vector : v ) simd( vector );
+//     scalar( v.tail() );
+//
+namespace detail {
+
+// iterator over the sub-spans of a view, by index:
+
+template< class View >
+class subspan_iterator
+{
+public:
+    typedef std::input_iterator_tag iterator_category;
+    typedef typename View::value_type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef value_type const * pointer;
+    typedef value_type reference;
+
+    gsl_api gsl_constexpr14 subspan_iterator( View const & view, size_t index ) gsl_noexcept
+        : view_( view ), index_( index ) {}
+
+    gsl_api gsl_constexpr14 reference operator*() const gsl_noexcept { return view_[ index_ ]; }
+
+    gsl_api gsl_constexpr14 subspan_iterator & operator++() gsl_noexcept { ++index_; return *this; }
+    gsl_api gsl_constexpr14 subspan_iterator operator++( int ) gsl_noexcept { subspan_iterator tmp( *this ); ++index_; return tmp; }
+
+    gsl_api gsl_constexpr14 friend bool operator==( subspan_iterator const & l, subspan_iterator const & r ) gsl_noexcept { return l.index_ == r.index_; }
+    gsl_api gsl_constexpr14 friend bool operator!=( subspan_iterator const & l, subspan_iterator const & r ) gsl_noexcept { return l.index_ != r.index_; }
+
+private:
+    View view_;
+    size_t index_;
+};
+} // namespace detail
+
+// consecutive chunks of chunk_size elements, the last chunk may be shorter:
+
+template< class T >
+class chunk_view
+{
+public:
+    typedef size_t index_type;
+
+    typedef span<T> value_type;
+    typedef T * pointer;
+    typedef detail::subspan_iterator< chunk_view > iterator;
+
+    gsl_api gsl_constexpr14 chunk_view( span<T> s, index_type chunk_size_in )
+        : data_( s.data() )
+        , size_( s.size() )
+        , chunk_size_( chunk_size_in )
+    {
+        Expects( chunk_size_in > 0 );
+    }
+
+    // not checked: index must be below size()
+    gsl_api gsl_constexpr14 span<T> operator[]( index_type index ) const gsl_noexcept
+    {
+        index_type const first = index * chunk_size_;
+        index_type const last  = size_ - first < chunk_size_ ? size_ : first + chunk_size_;
+
+        return span<T>( unchecked_t(), data_ + first, last - first );
+    }
+
+    gsl_api gsl_constexpr14 iterator begin() const gsl_noexcept
+    {
+        return iterator( *this, 0 );
+    }
+
+    gsl_api gsl_constexpr14 iterator end() const gsl_noexcept
+    {
+        return iterator( *this, size() );
+    }
+
+    // the number of chunks:
+
+    gsl_api gsl_constexpr14 index_type size() const gsl_noexcept
+    {
+        return ( size_ + chunk_size_ - 1 ) / chunk_size_;
+    }
+
+    gsl_api gsl_constexpr14 bool empty() const gsl_noexcept
+    {
+        return size_ == 0;
+    }
+
+    gsl_api gsl_constexpr14 index_type chunk_size() const gsl_noexcept
+    {
+        return chunk_size_;
+    }
+
+    // the elements of the chunks of chunk_size() elements and of the shorter last chunk:
+
+    gsl_api gsl_constexpr14 span<T> body() const gsl_noexcept
+    {
+        return span<T>( unchecked_t(), data_, size_ / chunk_size_ * chunk_size_ );
+    }
+
+    gsl_api gsl_constexpr14 span<T> tail() const gsl_noexcept
+    {
+        return span<T>( unchecked_t(), data_ + size_ / chunk_size_ * chunk_size_, size_ % chunk_size_ );
+    }
+
+private:
+    typedef typename span<T>::unchecked_t unchecked_t;
+
+    pointer data_;
+    index_type size_;
+    index_type chunk_size_;
+};
+
+// windows of window_size elements that start step elements apart; elements
+// that do not fill a last window are not included:
+
+template< class T >
+class window_view
+{
+public:
+    typedef size_t index_type;
+
+    typedef span<T> value_type;
+    typedef T * pointer;
+    typedef detail::subspan_iterator< window_view > iterator;
+
+    gsl_api gsl_constexpr14 window_view( span<T> s, index_type window_size_in, index_type step_in = 1 )
+        : data_( s.data() )
+        , size_( s.size() )
+        , window_size_( window_size_in )
+        , step_( step_in )
+    {
+        Expects( window_size_in > 0 && step_in > 0 );
+    }
+
+    // not checked: index must be below size()
+    gsl_api gsl_constexpr14 span<T> operator[]( index_type index ) const gsl_noexcept
+    {
+        return span<T>( unchecked_t(), data_ + index * step_, window_size_ );
+    }
+
+    gsl_api gsl_constexpr14 iterator begin() const gsl_noexcept
+    {
+        return iterator( *this, 0 );
+    }
+
+    gsl_api gsl_constexpr14 iterator end() const gsl_noexcept
+    {
+        return iterator( *this, size() );
+    }
+
+    // the number of windows:
+
+    gsl_api gsl_constexpr14 index_type size() const gsl_noexcept
+    {
+        return size_ < window_size_ ? 0 : ( size_ - window_size_ ) / step_ + 1;
+    }
+
+    gsl_api gsl_constexpr14 bool empty() const gsl_noexcept
+    {
+        return size() == 0;
+    }
+
+    gsl_api gsl_constexpr14 index_type window_size() const gsl_noexcept
+    {
+        return window_size_;
+    }
+
+    gsl_api gsl_constexpr14 index_type step() const gsl_noexcept
+    {
+        return step_;
+    }
+
+private:
+    typedef typename span<T>::unchecked_t unchecked_t;
+
+    pointer data_;
+    index_type size_;
+    index_type window_size_;
+    index_type step_;
+};
+
+// a span split into a head before the first address at the alignment, a body
+// of chunks of alignment bytes and a tail too short for a chunk; iterates the
+// chunks of the body:
+
+template< class T >
+class aligned_chunk_view
+{
+public:
+    typedef size_t index_type;
+
+    typedef span<T> value_type;
+    typedef T * pointer;
+    typedef detail::subspan_iterator< aligned_chunk_view > iterator;
+
+    gsl_api aligned_chunk_view( span<T> s, index_type alignment )
+        : data_( s.data() )
+        , head_( s.size() )
+        , body_( 0 )
+        , size_( s.size() )
+        , chunk_size_( alignment / sizeof( T ) )
+    {
+        Expects( alignment > 0 && ( alignment & ( alignment - 1 ) ) == 0 && alignment % sizeof( T ) == 0 );
+
+        // the alignment is reachable if the misalignment is a whole number of elements:
+
+        index_type const misalignment = reinterpret_cast<size_t>( data_ ) & ( alignment - 1 );
+
+        if ( misalignment % sizeof( T ) == 0 )
+        {
+            index_type const head = ( alignment - misalignment ) % alignment / sizeof( T );
+
+            if ( head <= size_ )
+            {
+                head_ = head;
+                body_ = ( size_ - head ) / chunk_size_ * chunk_size_;
+            }
+        }
+    }
+
+    // not checked: index must be below size()
+    gsl_api gsl_constexpr14 span<T> operator[]( index_type index ) const gsl_noexcept
+    {
+        return span<T>( unchecked_t(), data_ + head_ + index * chunk_size_, chunk_size_ );
+    }
+
+    gsl_api gsl_constexpr14 iterator begin() const gsl_noexcept
+    {
+        return iterator( *this, 0 );
+    }
+
+    gsl_api gsl_constexpr14 iterator end() const gsl_noexcept
+    {
+        return iterator( *this, size() );
+    }
+
+    // the number of chunks in the body:
+
+    gsl_api gsl_constexpr14 index_type size() const gsl_noexcept
+    {
+        return body_ / chunk_size_;
+    }
+
+    gsl_api gsl_constexpr14 bool empty() const gsl_noexcept
+    {
+        return body_ == 0;
+    }
+
+    gsl_api gsl_constexpr14 index_type chunk_size() const gsl_noexcept
+    {
+        return chunk_size_;
+    }
+
+    gsl_api gsl_constexpr14 span<T> head() const gsl_noexcept
+    {
+        return span<T>( unchecked_t(), data_, head_ );
+    }
+
+    gsl_api gsl_constexpr14 span<T> body() const gsl_noexcept
+    {
+        return span<T>( unchecked_t(), data_ + head_, body_ );
+    }
+
+    gsl_api gsl_constexpr14 span<T> tail() const gsl_noexcept
+    {
+        return span<T>( unchecked_t(), data_ + head_ + body_, size_ - head_ - body_ );
+    }
+
+private:
+    typedef typename span<T>::unchecked_t unchecked_t;
+
+    pointer data_;
+    index_type head_;
+    index_type body_;
+    index_type size_;
+    index_type chunk_size_;
+};
+
+template< class T, size_t N >
+gsl_api gsl_constexpr14 chunk_view<T> chunks( span<T, N> s, size_t chunk_size )
+{
+    return chunk_view<T>( s, chunk_size );
+}
+
+template< class T, size_t N >
+gsl_api gsl_constexpr14 window_view<T> windows( span<T, N> s, size_t window_size, size_t step = 1 )
+{
+    return window_view<T>( s, window_size, step );
+}
+
+template< class T, size_t N >
+gsl_api aligned_chunk_view<T> aligned_chunks( span<T, N> s, size_t alignment )
+{
+    return aligned_chunk_view<T>( s, alignment );
+}
+
+//
+// strided_span<> - A view of count T's that are stride bytes apart,
+// e.g. one member of an array of structs or one channel of interleaved samples:
+//
+//     strided_span<int> keys = as_strided_span( records, &record::key );
+//     strided_span<float> left = as_strided_span( samples, 2 );
+//
+// See also gather() and scatter().
+//
+namespace detail {
+
+// pointer p advanced by n bytes:
+
+template< class T >
+gsl_api gsl_constexpr14 T * advance_bytes( T * p, std::ptrdiff_t n ) gsl_noexcept
+{
+    return reinterpret_cast<T *>( const_cast<char *>( reinterpret_cast<char const volatile *>( p ) ) + n );
+}
+
+template< class T >
+class strided_iterator
+{
+public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef typename remove_cv<T>::type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T * pointer;
+    typedef T & reference;
+
+    gsl_api gsl_constexpr14 strided_iterator() gsl_noexcept
+        : base_( 0 ), stride_( 0 ), index_( 0 ) {}
+
+    gsl_api gsl_constexpr14 strided_iterator( pointer base, difference_type stride, difference_type index ) gsl_noexcept
+        : base_( base ), stride_( stride ), index_( index ) {}
+
+    gsl_api gsl_constexpr14 reference operator*() const gsl_noexcept { return *advance_bytes( base_, index_ * stride_ ); }
+    gsl_api gsl_constexpr14 pointer  operator->() const gsl_noexcept { return advance_bytes( base_, index_ * stride_ ); }
+    gsl_api gsl_constexpr14 reference operator[]( difference_type n ) const gsl_noexcept { return *advance_bytes( base_, ( index_ + n ) * stride_ ); }
+
+    gsl_api gsl_constexpr14 strided_iterator & operator++() gsl_noexcept { ++index_; return *this; }
+    gsl_api gsl_constexpr14 strided_iterator & operator--() gsl_noexcept { --index_; return *this; }
+    gsl_api gsl_constexpr14 strided_iterator operator++( int ) gsl_noexcept { strided_iterator tmp( *this ); ++index_; return tmp; }
+    gsl_api gsl_constexpr14 strided_iterator operator--( int ) gsl_noexcept { strided_iterator tmp( *this ); --index_; return tmp; }
+
+    gsl_api gsl_constexpr14 strided_iterator & operator+=( difference_type n ) gsl_noexcept { index_ += n; return *this; }
+    gsl_api gsl_constexpr14 strided_iterator & operator-=( difference_type n ) gsl_noexcept { index_ -= n; return *this; }
+
+    gsl_api gsl_constexpr14 friend strided_iterator operator+( strided_iterator it, difference_type n ) gsl_noexcept { return it += n; }
+    gsl_api gsl_constexpr14 friend strided_iterator operator+( difference_type n, strided_iterator it ) gsl_noexcept { return it += n; }
+    gsl_api gsl_constexpr14 friend strided_iterator operator-( strided_iterator it, difference_type n ) gsl_noexcept { return it -= n; }
+
+    gsl_api gsl_constexpr14 friend difference_type operator-( strided_iterator const & l, strided_iterator const & r ) gsl_noexcept { return l.index_ - r.index_; }
+
+    gsl_api gsl_constexpr14 friend bool operator==( strided_iterator const & l, strided_iterator const & r ) gsl_noexcept { return l.index_ == r.index_ && l.base_ == r.base_; }
+    gsl_api gsl_constexpr14 friend bool operator!=( strided_iterator const & l, strided_iterator const & r ) gsl_noexcept { return !( l == r ); }
+    gsl_api gsl_constexpr14 friend bool operator< ( strided_iterator const & l, strided_iterator const & r ) gsl_noexcept { return l.index_ <  r.index_; }
+    gsl_api gsl_constexpr14 friend bool operator<=( strided_iterator const & l, strided_iterator const & r ) gsl_noexcept { return l.index_ <= r.index_; }
+    gsl_api gsl_constexpr14 friend bool operator> ( strided_iterator const & l, strided_iterator const & r ) gsl_noexcept { return l.index_ >  r.index_; }
+    gsl_api gsl_constexpr14 friend bool operator>=( strided_iterator const & l, strided_iterator const & r ) gsl_noexcept { return l.index_ >= r.index_; }
+
+private:
+    pointer base_;
+    difference_type stride_;
+    difference_type index_;
+};
+} // namespace detail
+
+// tag to specify the stride in bytes:
+
+struct with_byte_stride_t{ gsl_constexpr14 with_byte_stride_t(){} };
+const with_byte_stride_t with_byte_stride;
+
+template< class T >
+class strided_span
+{
+public:
+    typedef size_t index_type;
+
+    typedef T element_type;
+    typedef T & reference;
+    typedef T * pointer;
+
+    typedef detail::strided_iterator<T> iterator;
+    typedef std::ptrdiff_t difference_type;
+
+    gsl_api gsl_constexpr14 strided_span() gsl_noexcept
+        : data_( 0 )
+        , size_( 0 )
+        , stride_( 0 )
+    {}
+
+    // size elements, stride elements of T apart:
+
+    gsl_api gsl_constexpr14 strided_span( pointer data_in, index_type size_in, difference_type stride_in ) gsl_noexcept
+        : data_( data_in )
+        , size_( size_in )
+        , stride_( stride_in * static_cast<difference_type>( sizeof( T ) ) )
+    {}
+
+    // size elements, stride_bytes bytes apart:
+
+    gsl_api gsl_constexpr14 strided_span( with_byte_stride_t, pointer data_in, index_type size_in, difference_type stride_bytes ) gsl_noexcept
+        : data_( data_in )
+        , size_( size_in )
+        , stride_( stride_bytes )
+    {}
+
+    // all elements of a span:
+
+    gsl_api gsl_constexpr14 strided_span( span<T> s ) gsl_noexcept
+        : data_( s.data() )
+        , size_( s.size() )
+        , stride_( sizeof( T ) )
+    {}
+
+    template< class U >
+    gsl_api gsl_constexpr14 strided_span( strided_span<U> const & other ) gsl_noexcept
+        : data_( other.data() )
+        , size_( other.size() )
+        , stride_( other.byte_stride() )
+    {}
+
+    gsl_api gsl_constexpr14 strided_span first( index_type count ) const
+    {
+        Expects( count <= size() );
+        return strided_span( with_byte_stride, data_, count, stride_ );
+    }
+
+    gsl_api gsl_constexpr14 strided_span last( index_type count ) const
+    {
+        Expects( count <= size() );
+        return strided_span( with_byte_stride, address( size() - count ), count, stride_ );
+    }
+
+    gsl_api gsl_constexpr14 strided_span subspan( index_type offset ) const
+    {
+        Expects( offset <= size() );
+        return strided_span( with_byte_stride, address( offset ), size() - offset, stride_ );
+    }
+
+    gsl_api gsl_constexpr14 strided_span subspan( index_type offset, index_type count ) const
+    {
+        Expects( offset <= size() && count <= size() - offset );
+        return strided_span( with_byte_stride, address( offset ), count, stride_ );
+    }
+
+    // count elements from offset on, taking every step-th element:
+
+    gsl_api gsl_constexpr14 strided_span subspan( index_type offset, index_type count, index_type step ) const
+    {
+        Expects( step > 0 && offset <= size() && ( count == 0 || ( offset < size() && count - 1 <= ( size() - offset - 1 ) / step ) ) );
+        return strided_span( with_byte_stride, address( offset ), count, stride_ * static_cast<difference_type>( step ) );
+    }
+
+    gsl_api gsl_constexpr14 iterator begin() const gsl_noexcept
+    {
+        return iterator( data_, stride_, 0 );
+    }
+
+    gsl_api gsl_constexpr14 iterator end() const gsl_noexcept
+    {
+        return iterator( data_, stride_, static_cast<difference_type>( size_ ) );
+    }
+
+    gsl_api gsl_constexpr14 reference operator[]( index_type index ) const
+    {
+        return at( index );
+    }
+
+    gsl_api gsl_constexpr14 reference operator()( index_type index ) const
+    {
+        return at( index );
+    }
+
+    gsl_api gsl_constexpr14 reference at( index_type index ) const
+    {
+        Expects( index < size() );
+        return *address( index );
+    }
+
+    gsl_api gsl_constexpr14 pointer data() const gsl_noexcept
+    {
+        return data_;
+    }
+
+    gsl_api gsl_constexpr14 index_type size() const gsl_noexcept
+    {
+        return size_;
+    }
+
+    gsl_api gsl_constexpr14 bool empty() const gsl_noexcept
+    {
+        return size_ == 0;
+    }
+
+    // distance between elements in bytes, may be negative:
+
+    gsl_api gsl_constexpr14 difference_type byte_stride() const gsl_noexcept
+    {
+        return stride_;
+    }
+
+    // the elements are adjacent, as in a span:
+
+    gsl_api gsl_constexpr14 bool is_contiguous() const gsl_noexcept
+    {
+        return stride_ == static_cast<difference_type>( sizeof( T ) ) || size_ <= 1;
+    }
+
+private:
+    gsl_api gsl_constexpr14 pointer address( index_type index ) const gsl_noexcept
+    {
+        return detail::advance_bytes( data_, static_cast<difference_type>( index ) * stride_ );
+    }
+
+    pointer data_;
+    index_type size_;
+    difference_type stride_;
+};
+
+// strided_span creator functions
+
+// every stride-th element of a span, from the first on:
+
+template< class T, size_t N >
+gsl_api gsl_constexpr14 strided_span<T> as_strided_span( span<T, N> s, size_t stride )
+{
+    Expects( stride > 0 );
+    return strided_span<T>( s.data(), ( s.size() + stride - 1 ) / stride, static_cast<std::ptrdiff_t>( stride ) );
+}
+
+// member m of each element of a span of structs:
+
+template< class S, size_t N, class M >
+gsl_api strided_span<M> as_strided_span( span<S, N> s, M S::* m )
+{
+    return strided_span<M>( with_byte_stride, s.empty() ? 0 : &( s.data()->*m ), s.size(), sizeof( S ) );
+}
+
+template< class S, size_t N, class M >
+gsl_api strided_span<const M> as_strided_span( span<const S, N> s, M S::* m )
+{
+    return strided_span<const M>( with_byte_stride, s.empty() ? 0 : &( s.data()->*m ), s.size(), sizeof( S ) );
+}
+
+namespace detail {
+
+// elements of a strided_span<T> may be gathered into a span<U>, four per iteration:
+
+template< class T, class U >
+void gather_n( T * src, std::ptrdiff_t stride, size_t count, U * dest, false_type )
+{
+    size_t i = 0;
+    for ( ; i + 4 <= count; i += 4, src = advance_bytes( src, 4 * stride ) )
+    {
+        dest[i    ] = *src;
+        dest[i + 1] = *advance_bytes( src,     stride );
+        dest[i + 2] = *advance_bytes( src, 2 * stride );
+        dest[i + 3] = *advance_bytes( src, 3 * stride );
+    }
+    for ( ; i < count; ++i, src = advance_bytes( src, stride ) )
+        dest[i] = *src;
+}
+
+#if gsl_HAVE_AVX2
+
+// elements of 4 or 8 bytes, 8 or 4 at a time with a hardware gather; the byte
+// offsets of a vector of elements must fit in 32 bits:
+
+template< class T, class U >
+void gather_n( T * src, std::ptrdiff_t stride, size_t count, U * dest, true_type )
+{
+    std::ptrdiff_t const limit = static_cast<std::ptrdiff_t>( 0x7fffffff / 8 );
+
+    if ( ( sizeof( U ) != 4 && sizeof( U ) != 8 ) || stride > limit || stride < -limit )
+        return gather_n( src, stride, count, dest, false_type() );
+
+    int const s = static_cast<int>( stride );
+    size_t const lanes = 32 / sizeof( U );
+    size_t i = 0;
+
+    if ( sizeof( U ) == 4 )
+    {
+        __m256i const offsets = _mm256_setr_epi32( 0, s, 2 * s, 3 * s, 4 * s, 5 * s, 6 * s, 7 * s );
+        for ( ; i + lanes <= count; i += lanes, src = advance_bytes( src, 8 * stride ) )
+        {
+            __m256i const v = _mm256_i32gather_epi32( reinterpret_cast<int const *>( src ), offsets, 1 );
+            _mm256_storeu_si256( reinterpret_cast<__m256i *>( dest + i ), v );
+        }
+    }
+    else
+    {
+        __m128i const offsets = _mm_setr_epi32( 0, s, 2 * s, 3 * s );
+        for ( ; i + lanes <= count; i += lanes, src = advance_bytes( src, 4 * stride ) )
+        {
+            __m256i const v = _mm256_i32gather_epi64( reinterpret_cast<long long const *>( src ), offsets, 1 );
+            _mm256_storeu_si256( reinterpret_cast<__m256i *>( dest + i ), v );
+        }
+    }
+    gather_n( src, stride, count - i, dest + i, false_type() );
+}
+
+#else // gsl_HAVE_AVX2
+
+template< class T, class U >
+void gather_n( T * src, std::ptrdiff_t stride, size_t count, U * dest, true_type )
+{
+    gather_n( src, stride, count, dest, false_type() );
+}
+
+#endif // gsl_HAVE_AVX2
+
+// there is no scatter instruction below AVX-512; store four per iteration:
+
+template< class T, class U >
+void scatter_n( T const * src, size_t count, U * dest, std::ptrdiff_t stride )
+{
+    size_t i = 0;
+    for ( ; i + 4 <= count; i += 4, dest = advance_bytes( dest, 4 * stride ) )
+    {
+        *dest                             = src[i    ];
+        *advance_bytes( dest,     stride ) = src[i + 1];
+        *advance_bytes( dest, 2 * stride ) = src[i + 2];
+        *advance_bytes( dest, 3 * stride ) = src[i + 3];
+    }
+    for ( ; i < count; ++i, dest = advance_bytes( dest, stride ) )
+        *dest = src[i];
+}
+} // namespace detail
+
+// gather(): copy the elements of a strided_span to the start of a contiguous span.
+
+template< class T, class U, size_t N >
+void gather( strided_span<T> src, span<U, N> dest )
+{
+    Expects( dest.size() >= src.size() );
+    detail::gather_n( src.data(), src.byte_stride(), src.size(), dest.data(), detail::is_bytewise_copyable<T, U>() );
+}
+
+// scatter(): copy the elements of a contiguous span to the start of a strided_span.
+
+template< class T, size_t N, class U >
+void scatter( span<T, N> src, strided_span<U> dest )
+{
+    Expects( dest.size() >= src.size() );
+    detail::scatter_n( src.data(), src.size(), dest.data(), dest.byte_stride() );
+}
+
+//
+// dyn_array<> - An owning array of T's of a size fixed on construction, aligned
+// to at least Alignment bytes. It converts to span<T> and span<const T>:
+//
+//     dyn_array<float, 64> samples( n, with_default_init );
+//     process( samples );
+//
+// Unlike std::vector it has no capacity and can be created without
+// initializing elements of trivially default constructible types.
+//
+namespace detail {
+
+template< class T >
+struct alignment_of
+{
+#if gsl_CPP11_OR_GREATER
+    static const size_t value = alignof( T );
+#else
+    struct holder { char c; T t; };
+    static const size_t value = sizeof( holder ) - sizeof( T );
+#endif
+};
+
+union max_align
+{
+    long double ld;
+    long long ll;
+    double d;
+    void * p;
+    void (*f)();
+};
+
+// alignment guaranteed by ::operator new:
+
+const size_t new_alignment = alignment_of< max_align >::value;
+
+inline void * aligned_allocate( size_t bytes, size_t alignment )
+{
+    if ( alignment <= new_alignment )
+        return ::operator new( bytes );
+
+    if ( bytes > std::numeric_limits<size_t>::max() - alignment - sizeof( void * ) )
+        throw std::bad_alloc();
+
+    // over-allocate, remember the allocated block just before the aligned one:
+
+    void * const block = ::operator new( bytes + alignment + sizeof( void * ) );
+    size_t const address = reinterpret_cast<size_t>( block ) + sizeof( void * );
+    void ** const aligned = reinterpret_cast<void **>( ( address + alignment - 1 ) & ~( alignment - 1 ) );
+    aligned[-1] = block;
+    return aligned;
+}
+
+inline void aligned_deallocate( void * p, size_t alignment ) gsl_noexcept
+{
+    if ( p == 0 )
+        return;
+
+    ::operator delete( alignment <= new_alignment ? p : static_cast<void **>( p )[-1] );
+}
+
+// element initializers for construct_n():
+
+template< class T >
+struct value_init
+{
+    void operator()( T * p, size_t ) const { new ( p ) T(); }
+};
+
+template< class T >
+struct default_init
+{
+    void operator()( T * p, size_t ) const { new ( p ) T; }
+};
+
+// element i is a copy of src[ i * step ]:
+
+template< class T >
+struct copy_init
+{
+    copy_init( T const * src_, size_t step_ ) : src( src_ ), step( step_ ) {}
+    void operator()( T * p, size_t i ) const { new ( p ) T( src[ i * step ] ); }
+
+    T const * src;
+    size_t step;
+};
+
+#if gsl_CPP11_OR_GREATER
+
+// element i is moved from src[ i ]:
+
+template< class T >
+struct move_init
+{
+    explicit move_init( T * src_ ) : src( src_ ) {}
+    void operator()( T * p, size_t i ) const { new ( p ) T( std::move( src[ i ] ) ); }
+
+    T * src;
+};
+#endif
+
+template< class T >
+void destroy_n( T * p, size_t count ) gsl_noexcept
+{
+    for ( size_t i = count; i > 0; --i )
+        p[ i - 1 ].~T();
+}
+
+// construct count elements in raw storage, none remain on an exception:
+
+template< class T, class Init >
+void construct_n( T * p, size_t count, Init init )
+{
+    size_t i = 0;
+    try
+    {
+        for ( ; i < count; ++i )
+            init( p + i, i );
+    }
+    catch ( ... )
+    {
+        destroy_n( p, i );
+        throw;
+    }
+}
+} // namespace detail
+
+// tag to leave elements of trivially default constructible types uninitialized:
+
+struct with_default_init_t{ gsl_constexpr14 with_default_init_t(){} };
+const with_default_init_t with_default_init;
+
+template< class T, size_t Alignment = detail::alignment_of<T>::value >
+class dyn_array
+{
+public:
+    typedef size_t index_type;
+    typedef size_t size_type;
+
+    typedef T value_type;
+    typedef T element_type;
+    typedef T & reference;
+    typedef T * pointer;
+    typedef T const & const_reference;
+    typedef T const * const_pointer;
+
+    typedef pointer iterator;
+    typedef const_pointer const_iterator;
+
+    gsl_api dyn_array() gsl_noexcept
+        : data_( 0 )
+        , size_( 0 )
+    {}
+
+    // size value-initialized elements:
+
+    gsl_api explicit dyn_array( size_type size_in )
+        : data_( allocate( size_in ) )
+        , size_( size_in )
+    {
+        construct( detail::value_init<T>() );
+    }
+
+    // size default-initialized elements, indeterminate for trivial types:
+
+    gsl_api dyn_array( size_type size_in, with_default_init_t )
+        : data_( allocate( size_in ) )
+        , size_( size_in )
+    {
+        construct( detail::default_init<T>() );
+    }
+
+    gsl_api dyn_array( size_type size_in, T const & value )
+        : data_( allocate( size_in ) )
+        , size_( size_in )
+    {
+        construct( detail::copy_init<T>( &value, 0 ) );
+    }
+
+    gsl_api explicit dyn_array( span<const T> s )
+        : data_( allocate( s.size() ) )
+        , size_( s.size() )
+    {
+        construct( detail::copy_init<T>( s.data(), 1 ) );
+    }
+
+    gsl_api dyn_array( dyn_array const & other )
+        : data_( allocate( other.size() ) )
+        , size_( other.size() )
+    {
+        construct( detail::copy_init<T>( other.data(), 1 ) );
+    }
+
+#if gsl_CPP11_OR_GREATER
+    gsl_api dyn_array( dyn_array && other ) gsl_noexcept
+        : data_( other.data_ )
+        , size_( other.size_ )
+    {
+        other.data_ = 0;
+        other.size_ = 0;
+    }
+
+    gsl_api dyn_array & operator=( dyn_array && other ) gsl_noexcept
+    {
+        dyn_array( std::move( other ) ).swap( *this );
+        return *this;
+    }
+#endif
+
+    gsl_api dyn_array & operator=( dyn_array const & other )
+    {
+        dyn_array( other ).swap( *this );
+        return *this;
+    }
+
+    gsl_api ~dyn_array()
+    {
+        detail::destroy_n( data_, size_ );
+        detail::aligned_deallocate( data_, Alignment );
+    }
+
+    gsl_api void swap( dyn_array & other ) gsl_noexcept
+    {
+        using std::swap;
+        swap( data_, other.data_ );
+        swap( size_, other.size_ );
+    }
+
+    gsl_api reference operator[]( index_type index )
+    {
+        Expects( index < size_ );
+        return data_[ index ];
+    }
+
+    gsl_api const_reference operator[]( index_type index ) const
+    {
+        Expects( index < size_ );
+        return data_[ index ];
+    }
+
+    gsl_api reference at( index_type index )
+    {
+        return (*this)[ index ];
+    }
+
+    gsl_api const_reference at( index_type index ) const
+    {
+        return (*this)[ index ];
+    }
+
+    gsl_api pointer data() gsl_noexcept
+    {
+        return data_;
+    }
+
+    gsl_api const_pointer data() const gsl_noexcept
+    {
+        return data_;
+    }
+
+    gsl_api iterator begin() gsl_noexcept
+    {
+        return data_;
+    }
+
+    gsl_api iterator end() gsl_noexcept
+    {
+        return data_ + size_;
+    }
+
+    gsl_api const_iterator begin() const gsl_noexcept
+    {
+        return data_;
+    }
+
+    gsl_api const_iterator end() const gsl_noexcept
+    {
+        return data_ + size_;
+    }
+
+    gsl_api size_type size() const gsl_noexcept
+    {
+        return size_;
+    }
+
+    gsl_api bool empty() const gsl_noexcept
+    {
+        return size_ == 0;
+    }
+
+    gsl_api static size_t alignment() gsl_noexcept
+    {
+        return Alignment;
+    }
+
+private:
+    static pointer allocate( size_type size_in )
+    {
+        gsl_STATIC_ASSERT( Alignment > 0 && ( Alignment & ( Alignment - 1 ) ) == 0, "dyn_array: Alignment must be a power of two" );
+        gsl_STATIC_ASSERT( Alignment >= detail::alignment_of<T>::value, "dyn_array: Alignment must be at least the alignment of T" );
+
+        if ( size_in == 0 )
+            return 0;
+
+        if ( size_in > std::numeric_limits<size_type>::max() / sizeof( T ) )
+            throw std::bad_alloc();
+
+        return static_cast<pointer>( detail::aligned_allocate( size_in * sizeof( T ), Alignment ) );
+    }
+
+    // construct the elements, release the storage on an exception:
+
+    template< class Init >
+    void construct( Init init )
+    {
+        try
+        {
+            detail::construct_n( data_, size_, init );
+        }
+        catch ( ... )
+        {
+            detail::aligned_deallocate( data_, Alignment );
+            throw;
+        }
+    }
+
+    pointer data_;
+    size_type size_;
+};
+
+template< class T, size_t A >
+gsl_api span<T> as_span( dyn_array<T, A> & arr )
+{
+    return span<T>( arr.data(), arr.size() );
+}
+
+template< class T, size_t A >
+gsl_api span<const T> as_span( dyn_array<T, A> const & arr )
+{
+    return span<const T>( arr.data(), arr.size() );
+}
+
+//
+// small_buffer<> - An owning array of T's of a size fixed on construction that
+// keeps up to N elements inline and only allocates larger arrays on the heap.
+// It converts to span<T> and span<const T>:
+//
+//     small_buffer<int, 16> indices( count );
+//     collect( indices );
+//
+// Types aligned beyond what ::operator new guarantees are not supported.
+//
+template< class T, size_t N >
+class small_buffer
+{
+public:
+    typedef size_t index_type;
+    typedef size_t size_type;
+
+    typedef T value_type;
+    typedef T element_type;
+    typedef T & reference;
+    typedef T * pointer;
+    typedef T const & const_reference;
+    typedef T const * const_pointer;
+
+    typedef pointer iterator;
+    typedef const_pointer const_iterator;
+
+    gsl_api small_buffer() gsl_noexcept
+        : data_( inline_data() )
+        , size_( 0 )
+    {}
+
+    // size value-initialized elements:
+
+    gsl_api explicit small_buffer( size_type size_in )
+        : data_( allocate( size_in ) )
+        , size_( size_in )
+    {
+        construct( detail::value_init<T>() );
+    }
+
+    // size default-initialized elements, indeterminate for trivial types:
+
+    gsl_api small_buffer( size_type size_in, with_default_init_t )
+        : data_( allocate( size_in ) )
+        , size_( size_in )
+    {
+        construct( detail::default_init<T>() );
+    }
+
+    gsl_api small_buffer( size_type size_in, T const & value )
+        : data_( allocate( size_in ) )
+        , size_( size_in )
+    {
+        construct( detail::copy_init<T>( &value, 0 ) );
+    }
+
+    gsl_api explicit small_buffer( span<const T> s )
+        : data_( allocate( s.size() ) )
+        , size_( s.size() )
+    {
+        construct( detail::copy_init<T>( s.data(), 1 ) );
+    }
+
+    gsl_api small_buffer( small_buffer const & other )
+        : data_( allocate( other.size() ) )
+        , size_( other.size() )
+    {
+        construct( detail::copy_init<T>( other.data(), 1 ) );
+    }
+
+    gsl_api small_buffer & operator=( small_buffer const & other )
+    {
+        if ( this != &other )
+        {
+            small_buffer tmp( other );
+            release();
+            take( tmp );
+        }
+        return *this;
+    }
+
+#if gsl_CPP11_OR_GREATER
+    // a heap array is taken over, inline elements are moved:
+
+    gsl_api small_buffer( small_buffer && other )
+        : data_( inline_data() )
+        , size_( 0 )
+    {
+        take( other );
+    }
+
+    gsl_api small_buffer & operator=( small_buffer && other )
+    {
+        if ( this != &other )
+        {
+            release();
+            take( other );
+        }
+        return *this;
+    }
+#endif
+
+    gsl_api ~small_buffer()
+    {
+        release();
+    }
+
+    gsl_api reference operator[]( index_type index )
+    {
+        Expects( index < size_ );
+        return data_[ index ];
+    }
+
+    gsl_api const_reference operator[]( index_type index ) const
+    {
+        Expects( index < size_ );
+        return data_[ index ];
+    }
+
+    gsl_api reference at( index_type index )
+    {
+        return (*this)[ index ];
+    }
+
+    gsl_api const_reference at( index_type index ) const
+    {
+        return (*this)[ index ];
+    }
+
+    gsl_api pointer data() gsl_noexcept
+    {
+        return data_;
+    }
+
+    gsl_api const_pointer data() const gsl_noexcept
+    {
+        return data_;
+    }
+
+    gsl_api iterator begin() gsl_noexcept
+    {
+        return data_;
+    }
+
+    gsl_api iterator end() gsl_noexcept
+    {
+        return data_ + size_;
+    }
+
+    gsl_api const_iterator begin() const gsl_noexcept
+    {
+        return data_;
+    }
+
+    gsl_api const_iterator end() const gsl_noexcept
+    {
+        return data_ + size_;
+    }
+
+    gsl_api size_type size() const gsl_noexcept
+    {
+        return size_;
+    }
+
+    gsl_api bool empty() const gsl_noexcept
+    {
+        return size_ == 0;
+    }
+
+    // true if the elements live in the inline storage, not on the heap:
+
+    gsl_api bool is_inline() const gsl_noexcept
+    {
+        return data_ == inline_data();
+    }
+
+    gsl_api static size_type inline_capacity() gsl_noexcept
+    {
+        return N;
+    }
+
+private:
+    pointer inline_data() gsl_noexcept
+    {
+        return reinterpret_cast<pointer>( &storage_ );
+    }
+
+    const_pointer inline_data() const gsl_noexcept
+    {
+        return reinterpret_cast<const_pointer>( &storage_ );
+    }
+
+    pointer allocate( size_type size_in )
+    {
+        gsl_STATIC_ASSERT( N > 0, "small_buffer: N must be positive" );
+        gsl_STATIC_ASSERT( detail::alignment_of<T>::value <= detail::new_alignment, "small_buffer: T must not be over-aligned" );
+
+        if ( size_in <= N )
+            return inline_data();
+
+        if ( size_in > std::numeric_limits<size_type>::max() / sizeof( T ) )
+            throw std::bad_alloc();
+
+        return static_cast<pointer>( ::operator new( size_in * sizeof( T ) ) );
+    }
+
+    // construct the elements, release heap storage on an exception:
+
+    template< class Init >
+    void construct( Init init )
+    {
+        try
+        {
+            detail::construct_n( data_, size_, init );
+        }
+        catch ( ... )
+        {
+            if ( !is_inline() )
+                ::operator delete( data_ );
+            throw;
+        }
+    }
+
+    // destroy the elements, release heap storage and become empty:
+
+    void release() gsl_noexcept
+    {
+        detail::destroy_n( data_, size_ );
+
+        if ( !is_inline() )
+            ::operator delete( data_ );
+
+        data_ = inline_data();
+        size_ = 0;
+    }
+
+    // take the elements of other, which becomes empty; requires this to be empty:
+
+    void take( small_buffer & other )
+    {
+        if ( !other.is_inline() )
+        {
+            data_ = other.data_;
+            size_ = other.size_;
+            other.data_ = other.inline_data();
+            other.size_ = 0;
+            return;
+        }
+
+#if gsl_CPP11_OR_GREATER
+        detail::construct_n( data_, other.size_, detail::move_init<T>( other.data_ ) );
+#else
+        detail::construct_n( data_, other.size_, detail::copy_init<T>( other.data_, 1 ) );
+#endif
+        size_ = other.size_;
+        other.release();
+    }
+
+    pointer data_;
+    size_type size_;
+
+    union
+    {
+        detail::max_align align_;
+        unsigned char bytes_[ N * sizeof( T ) ];
+    } storage_;
+};
+
+template< class T, size_t N >
+gsl_api span<T> as_span( small_buffer<T, N> & buf )
+{
+    return span<T>( buf.data(), buf.size() );
+}
+
+template< class T, size_t N >
+gsl_api span<const T> as_span( small_buffer<T, N> const & buf )
+{
+    return span<const T>( buf.data(), buf.size() );
+}
+
+//
+// arena - A monotonic (bump-pointer) allocator. Arrays and objects are carved
+// from blocks of memory that are only released as a whole:
+//
+//     arena a;
+//     span<int> values = a.allocate<int>( n );
+//     owner<node *> root = a.create<node>( 42 );
+//     ...
+//     a.reset();    // destroys root, keeps the blocks for reuse
+//
+// The destructors of objects that are not trivially destructible are
+// registered on creation and run in reverse order on reset() and on
+// destruction of the arena. The first block may be a buffer supplied by the
+// caller; further blocks are chained and allocated with ::operator new.
+//
+namespace detail {
+
+#if gsl_HAVE_TYPE_TRAITS
+# if gsl_BETWEEN( gsl_COMPILER_GCC_VERSION, 1, 480 )
+template< class T > struct is_trivially_destructible { enum { value = std::has_trivial_destructor<T>::value }; };
+# else
+template< class T > struct is_trivially_destructible { enum { value = std::is_trivially_destructible<T>::value }; };
+# endif
+#else
+template< class T > struct is_trivially_destructible { enum { value = is_trivially_copyable<T>::value }; };
+#endif
+} // namespace detail
+
+class arena
+{
+public:
+    gsl_api explicit arena( size_t block_size_in = 4096 )
+        : initial_( 0 )
+        , initial_size_( 0 )
+        , blocks_( 0 )
+        , current_( 0 )
+        , pos_( 0 )
+        , end_( 0 )
+        , cleanups_( 0 )
+        , block_size_( block_size_in )
+    {}
+
+    // start with a buffer of the caller, which must outlive the arena:
+
+    gsl_api explicit arena( span<byte> buffer, size_t block_size_in = 4096 )
+        : initial_( reinterpret_cast<char *>( buffer.data() ) )
+        , initial_size_( buffer.size() )
+        , blocks_( 0 )
+        , current_( 0 )
+        , pos_( initial_ )
+        , end_( initial_ + initial_size_ )
+        , cleanups_( 0 )
+        , block_size_( block_size_in )
+    {}
+
+#if gsl_HAVE_IS_DELETE
+    gsl_api arena( arena const & ) = delete;
+    gsl_api arena & operator=( arena const & ) = delete;
+#endif
+
+    gsl_api ~arena()
+    {
+        run_cleanups();
+
+        while ( blocks_ )
+        {
+            block * const next = blocks_->next;
+            ::operator delete( blocks_ );
+            blocks_ = next;
+        }
+    }
+
+    // uninitialized storage of bytes size, aligned to alignment, a power of two:
+
+    gsl_api void * allocate_bytes( size_t bytes, size_t alignment = detail::new_alignment )
+    {
+        Expects( alignment > 0 && ( alignment & ( alignment - 1 ) ) == 0 );
+
+        size_t const padding = padding_for( pos_, alignment );
+
+        if ( padding > available() || bytes > available() - padding )
+            return bump( next_block( bytes, alignment ), bytes );
+
+        return bump( pos_ + padding, bytes );
+    }
+
+    // n value-initialized elements:
+
+    template< class T >
+    gsl_api span<T> allocate( size_t n )
+    {
+        return allocate_n<T>( n, detail::value_init<T>() );
+    }
+
+    // n default-initialized elements, indeterminate for trivial types:
+
+    template< class T >
+    gsl_api span<T> allocate( size_t n, with_default_init_t )
+    {
+        return allocate_n<T>( n, detail::default_init<T>() );
+    }
+
+#if gsl_HAVE_VARIADIC_TEMPLATES
+    template< class T, class... Args >
+    gsl_api owner<T *> create( Args &&... args )
+    {
+        void * const p = allocate_bytes( sizeof( T ), detail::alignment_of<T>::value );
+        cleanup * const c = make_cleanup<T>();
+        return registered( c, new ( p ) T( std::forward<Args>( args )... ), 1 );
+    }
+#else
+    template< class T >
+    gsl_api typename owner<T *>::type create()
+    {
+        void * const p = allocate_bytes( sizeof( T ), detail::alignment_of<T>::value );
+        cleanup * const c = make_cleanup<T>();
+        return registered( c, new ( p ) T(), 1 );
+    }
+
+    template< class T, class A1 >
+    gsl_api typename owner<T *>::type create( A1 const & a1 )
+    {
+        void * const p = allocate_bytes( sizeof( T ), detail::alignment_of<T>::value );
+        cleanup * const c = make_cleanup<T>();
+        return registered( c, new ( p ) T( a1 ), 1 );
+    }
+
+    template< class T, class A1, class A2 >
+    gsl_api typename owner<T *>::type create( A1 const & a1, A2 const & a2 )
+    {
+        void * const p = allocate_bytes( sizeof( T ), detail::alignment_of<T>::value );
+        cleanup * const c = make_cleanup<T>();
+        return registered( c, new ( p ) T( a1, a2 ), 1 );
+    }
+
+    template< class T, class A1, class A2, class A3 >
+    gsl_api typename owner<T *>::type create( A1 const & a1, A2 const & a2, A3 const & a3 )
+    {
+        void * const p = allocate_bytes( sizeof( T ), detail::alignment_of<T>::value );
+        cleanup * const c = make_cleanup<T>();
+        return registered( c, new ( p ) T( a1, a2, a3 ), 1 );
+    }
+#endif
+
+    // destroy all objects, make all blocks available again:
+
+    gsl_api void reset() gsl_noexcept
+    {
+        run_cleanups();
+
+        if ( initial_ || !blocks_ )
+        {
+            current_ = 0;
+            pos_ = initial_;
+            end_ = initial_ + initial_size_;
+        }
+        else
+        {
+            enter( blocks_ );
+        }
+    }
+
+    gsl_api size_t block_size() const gsl_noexcept
+    {
+        return block_size_;
+    }
+
+private:
+#if !gsl_HAVE_IS_DELETE
+    arena( arena const & );
+    arena & operator=( arena const & );
+#endif
+
+    struct block
+    {
+        block * next;
+        size_t size;
+    };
+
+    struct cleanup
+    {
+        void (*destroy)( void * p, size_t count );
+        void * p;
+        size_t count;
+        cleanup * next;
+    };
+
+    static size_t header_size() gsl_noexcept
+    {
+        return ( sizeof( block ) + detail::new_alignment - 1 ) & ~( detail::new_alignment - 1 );
+    }
+
+    static size_t padding_for( char const * p, size_t alignment ) gsl_noexcept
+    {
+        return ( alignment - reinterpret_cast<size_t>( p ) % alignment ) % alignment;
+    }
+
+    size_t available() const gsl_noexcept
+    {
+        return static_cast<size_t>( end_ - pos_ );
+    }
+
+    char * bump( char * p, size_t bytes ) gsl_noexcept
+    {
+        pos_ = p + bytes;
+        return p;
+    }
+
+    void enter( block * b ) gsl_noexcept
+    {
+        current_ = b;
+        pos_ = reinterpret_cast<char *>( b ) + header_size();
+        end_ = pos_ + b->size;
+    }
+
+    // continue in the next chained block that fits, or insert a new one; out
+    // of line, so that allocate_bytes() stays small and compilers do not take
+    // the new block for the full one in their bounds warnings:
+
+    gsl_NOINLINE char * next_block( size_t bytes, size_t alignment )
+    {
+        if ( bytes > std::numeric_limits<size_t>::max() - alignment - header_size() )
+            throw std::bad_alloc();
+
+        size_t const needed = bytes + alignment - 1;
+
+        block * next = current_ ? current_->next : blocks_;
+
+        while ( next && next->size < needed )
+            next = next->next;
+
+        if ( !next )
+        {
+            size_t const size = needed > block_size_ ? needed : block_size_;
+
+            next = static_cast<block *>( ::operator new( header_size() + size ) );
+            next->size = size;
+
+            if ( current_ )
+            {
+                next->next = current_->next;
+                current_->next = next;
+            }
+            else
+            {
+                next->next = blocks_;
+                blocks_ = next;
+            }
+        }
+
+        enter( next );
+        return pos_ + padding_for( pos_, alignment );
+    }
+
+    template< class T >
+    static void destroy( void * p, size_t count )
+    {
+        detail::destroy_n( static_cast<T *>( p ), count );
+    }
+
+    // record for the destructor of T, allocated before T is constructed:
+
+    template< class T >
+    cleanup * make_cleanup()
+    {
+        if ( detail::is_trivially_destructible<T>::value )
+            return 0;
+
+        cleanup * const c = static_cast<cleanup *>( allocate_bytes( sizeof( cleanup ), detail::alignment_of<cleanup>::value ) );
+        c->destroy = &destroy<T>;
+        return c;
+    }
+
+    template< class T >
+    T * registered( cleanup * c, T * p, size_t count ) gsl_noexcept
+    {
+        if ( c )
+        {
+            c->p = p;
+            c->count = count;
+            c->next = cleanups_;
+            cleanups_ = c;
+        }
+        return p;
+    }
+
+    template< class T, class Init >
+    span<T> allocate_n( size_t n, Init init )
+    {
+        if ( n > std::numeric_limits<size_t>::max() / sizeof( T ) )
+            throw std::bad_alloc();
+
+        T * const p = static_cast<T *>( allocate_bytes( n * sizeof( T ), detail::alignment_of<T>::value ) );
+        cleanup * const c = n ? make_cleanup<T>() : 0;
+
+        detail::construct_n( p, n, init );
+
+        return span<T>( registered( c, p, n ), n );
+    }
+
+    void run_cleanups() gsl_noexcept
+    {
+        for ( ; cleanups_; cleanups_ = cleanups_->next )
+            cleanups_->destroy( cleanups_->p, cleanups_->count );
+    }
+
+    char * initial_;
+    size_t initial_size_;
+    block * blocks_;
+    block * current_;
+    char * pos_;
+    char * end_;
+    cleanup * cleanups_;
+    size_t block_size_;
+};
+
+#if gsl_HAVE_THREAD
+
+//
+// object_pool<> - A pool of T's for threads that create and destroy many of
+// them. acquire() constructs a T and returns it as not_null<T*>, release()
+// destroys it and returns its memory to the pool:
+//
+//     object_pool<order> pool;
+//     not_null<order *> o = pool.acquire( id, quantity );
+//     ...
+//     pool.release( o );
+//
+// Each thread caches free slots per pool, so that most acquire()s and
+// release()s do not synchronize. A thread's cache is refilled from and
+// flushed to the shared free list of the pool in batches. The memory is
+// released on destruction of the pool; all objects must be released by then.
+//
+struct object_pool_statistics
+{
+    unsigned long long hits;        // acquire()s served from the cache of the thread
+    unsigned long long misses;      // acquire()s that refilled the cache from the pool
+    unsigned long long allocations; // slots allocated from the heap
+    unsigned long long flushes;     // batches returned from the cache of a thread to the pool
+};
+
+namespace detail {
+
+struct pool_slot
+{
+    pool_slot * next;
+};
+
+class pool_core;
+
+// the free slots of one pool cached by one thread:
+
+struct pool_cache
+{
+    explicit pool_cache( std::shared_ptr<pool_core> const & core_ )
+        : core( core_ ), head( nullptr ), count( 0 ), hits( 0 ) {}
+
+    void push( pool_slot * slot ) gsl_noexcept
+    {
+        slot->next = head;
+        head = slot;
+        ++count;
+    }
+
+    pool_slot * pop() gsl_noexcept
+    {
+        pool_slot * const slot = head;
+        head = slot->next;
+        --count;
+        return slot;
+    }
+
+    std::shared_ptr<pool_core> core;
+    pool_slot * head;
+    size_t count;
+    std::atomic<unsigned long long> hits;   // single writer: the owning thread
+};
+
+// the state of a pool shared by the threads that use it:
+
+class pool_core
+{
+public:
+    pool_core( size_t slot_size, size_t batch_size )
+        : slot_size_( slot_size ), batch_size_( batch_size ), free_( nullptr ), closed_( false )
+        , retired_hits_( 0 ), misses_( 0 ), allocations_( 0 ), flushes_( 0 ) {}
+
+    ~pool_core()
+    {
+        release_chunks();
+    }
+
+    size_t batch_size() const gsl_noexcept
+    {
+        return batch_size_;
+    }
+
+    bool closed() const gsl_noexcept
+    {
+        return closed_.load( std::memory_order_acquire );
+    }
+
+    void attach( pool_cache * cache )
+    {
+        std::lock_guard<std::mutex> lock( mutex_ );
+        caches_.push_back( cache );
+    }
+
+    // a thread is done with the pool: take back its slots, keep its hits:
+
+    void detach( pool_cache * cache ) gsl_noexcept
+    {
+        std::lock_guard<std::mutex> lock( mutex_ );
+
+        caches_.erase( std::remove( caches_.begin(), caches_.end(), cache ), caches_.end() );
+        retired_hits_ += cache->hits.load( std::memory_order_relaxed );
+
+        while ( !closed_ && cache->head )
+            push( cache->pop() );
+
+        cache->head = nullptr;
+        cache->count = 0;
+    }
+
+    // move a batch of free slots to the cache, allocating them if there are none:
+
+    void refill( pool_cache & cache )
+    {
+        std::lock_guard<std::mutex> lock( mutex_ );
+
+        ++misses_;
+
+        if ( !free_ )
+            allocate_chunk();
+
+        for ( size_t n = 0; free_ && n < batch_size_; ++n )
+        {
+            pool_slot * const slot = free_;
+            free_ = slot->next;
+            cache.push( slot );
+        }
+    }
+
+    // move a batch of slots from the cache to the pool:
+
+    void flush( pool_cache & cache ) gsl_noexcept
+    {
+        pool_slot * const first = cache.head;
+        pool_slot * last = first;
+
+        for ( size_t n = 1; n < batch_size_; ++n )
+            last = last->next;
+
+        cache.head = last->next;
+        cache.count -= batch_size_;
+
+        std::lock_guard<std::mutex> lock( mutex_ );
+
+        last->next = free_;
+        free_ = first;
+        ++flushes_;
+    }
+
+    // the pool is destroyed: release the memory, caches may still refer to it:
+
+    void close() gsl_noexcept
+    {
+        std::lock_guard<std::mutex> lock( mutex_ );
+
+        closed_.store( true, std::memory_order_release );
+        release_chunks();
+        free_ = nullptr;
+    }
+
+    object_pool_statistics statistics()
+    {
+        std::lock_guard<std::mutex> lock( mutex_ );
+
+        object_pool_statistics result = { retired_hits_, misses_, allocations_, flushes_ };
+
+        for ( size_t i = 0; i < caches_.size(); ++i )
+            result.hits += caches_[i]->hits.load( std::memory_order_relaxed );
+
+        return result;
+    }
+
+private:
+    void push( pool_slot * slot ) gsl_noexcept
+    {
+        slot->next = free_;
+        free_ = slot;
+    }
+
+    void allocate_chunk()
+    {
+        if ( batch_size_ > std::numeric_limits<size_t>::max() / slot_size_ )
+            throw std::bad_alloc();
+
+        chunks_.push_back( nullptr );
+        chunks_.back() = ::operator new( batch_size_ * slot_size_ );
+
+        char * const chunk = static_cast<char *>( chunks_.back() );
+
+        for ( size_t i = batch_size_; i > 0; --i )
+            push( reinterpret_cast<pool_slot *>( chunk + ( i - 1 ) * slot_size_ ) );
+
+        allocations_ += batch_size_;
+    }
+
+    void release_chunks() gsl_noexcept
+    {
+        for ( size_t i = 0; i < chunks_.size(); ++i )
+            ::operator delete( chunks_[i] );
+
+        chunks_.clear();
+    }
+
+    std::mutex mutex_;
+    size_t const slot_size_;
+    size_t const batch_size_;
+    pool_slot * free_;
+    std::vector< void * > chunks_;
+    std::vector< pool_cache * > caches_;
+    std::atomic<bool> closed_;
+    unsigned long long retired_hits_;
+    unsigned long long misses_;
+    unsigned long long allocations_;
+    unsigned long long flushes_;
+};
+
+// the caches of one thread, one per pool the thread used:
+
+class pool_cache_list
+{
+public:
+    pool_cache_list()
+        : last_( nullptr ) {}
+
+    ~pool_cache_list()
+    {
+        for ( size_t i = 0; i < caches_.size(); ++i )
+            drop( caches_[i] );
+    }
+
+    pool_cache & find( std::shared_ptr<pool_core> const & core )
+    {
+        if ( last_ && last_->core == core )
+            return *last_;
+
+        pool_cache * found = nullptr;
+
+        for ( size_t i = caches_.size(); i > 0; --i )
+        {
+            pool_cache * const cache = caches_[ i - 1 ];
+
+            if ( cache->core == core )
+            {
+                found = cache;
+            }
+            else if ( cache->core->closed() )
+            {
+                drop( cache );
+                caches_.erase( caches_.begin() + ( i - 1 ) );
+            }
+        }
+
+        if ( !found )
+        {
+            caches_.reserve( caches_.size() + 1 );
+            found = new pool_cache( core );
+            core->attach( found );
+            caches_.push_back( found );
+        }
+
+        return *( last_ = found );
+    }
+
+private:
+    static void drop( pool_cache * cache ) gsl_noexcept
+    {
+        cache->core->detach( cache );
+        delete cache;
+    }
+
+    std::vector< pool_cache * > caches_;
+    pool_cache * last_;
+};
+
+inline pool_cache & pool_cache_for( std::shared_ptr<pool_core> const & core )
+{
+    static thread_local pool_cache_list caches;
+    return caches.find( core );
+}
+} // namespace detail
+
+template< class T >
+class object_pool
+{
+public:
+    // slots move between a thread's cache and the pool batch_size at a time:
+
+    explicit object_pool( size_t batch_size = 32 )
+        : core_( std::make_shared<detail::pool_core>( slot_size(), batch_size ) )
+    {
+        Expects( batch_size > 0 );
+    }
+
+    object_pool( object_pool const & ) = delete;
+    object_pool & operator=( object_pool const & ) = delete;
+
+    ~object_pool()
+    {
+        core_->close();
+    }
+
+    template< class... Args >
+    not_null<T *> acquire( Args &&... args )
+    {
+        detail::pool_cache & cache = detail::pool_cache_for( core_ );
+
+        if ( cache.head )
+            cache.hits.store( cache.hits.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+        else
+            core_->refill( cache );
+
+        detail::pool_slot * const slot = cache.pop();
+
+        try
+        {
+            return not_null<T *>( new ( slot ) T( std::forward<Args>( args )... ) );
+        }
+        catch ( ... )
+        {
+            cache.push( slot );
+            throw;
+        }
+    }
+
+    void release( not_null<T *> p )
+    {
+        T * const object = p.get();
+        object->~T();
+
+        detail::pool_cache & cache = detail::pool_cache_for( core_ );
+
+        cache.push( reinterpret_cast<detail::pool_slot *>( object ) );
+
+        if ( cache.count >= 2 * core_->batch_size() )
+            core_->flush( cache );
+    }
+
+    object_pool_statistics statistics() const
+    {
+        return core_->statistics();
+    }
+
+private:
+    static size_t slot_size() gsl_noexcept
+    {
+        static_assert( detail::alignment_of<T>::value <= detail::new_alignment, "object_pool: T must not be over-aligned" );
+
+        size_t const align = detail::alignment_of<T>::value > detail::alignment_of<detail::pool_slot>::value
+                           ? detail::alignment_of<T>::value : detail::alignment_of<detail::pool_slot>::value;
+        size_t const size  = sizeof( T ) > sizeof( detail::pool_slot ) ? sizeof( T ) : sizeof( detail::pool_slot );
+
+        return ( size + align - 1 ) / align * align;
+    }
+
+    std::shared_ptr<detail::pool_core> core_;
+};
+
+#endif // gsl_HAVE_THREAD
+
+#if gsl_HAVE_MMAP || gsl_HAVE_UIO
+
+namespace detail {
+
+// report the failure of a system call as std::system_error (C++11) or std::runtime_error:
+
+inline void throw_errno( char const * what )
+{
+#if gsl_CPP11_OR_GREATER
+    throw std::system_error( errno, std::generic_category(), what );
+#else
+    throw std::runtime_error( std::string( what ) + ": " + std::strerror( errno ) );
+#endif
+}
+} // namespace detail
+
+#endif // gsl_HAVE_MMAP || gsl_HAVE_UIO
+
+#if gsl_HAVE_MMAP
+
+//
+// mapped_file - A file, or a range of it, mapped into memory (POSIX). Its
+// contents are available as span<const byte> or as a span of other types
+// without copying:
+//
+//     mapped_file f( "samples.bin" );
+//     f.advise( mapped_file::sequential );
+//     span<const float> samples = f.as_span<float>();
+//
+// Failure to open or to map the file throws std::system_error (C++11) or
+// std::runtime_error.
+//
+class mapped_file
+{
+public:
+    enum mode_type   { read_only, read_write };
+    enum flag_type   { no_flags = 0, populate = 1, huge_pages = 2 };
+    enum advice_type { normal, sequential, random, willneed, dontneed };
+
+    gsl_api mapped_file() gsl_noexcept
+        : fd_( -1 ), mode_( read_only ), flags_( no_flags ), file_size_( 0 )
+        , map_( 0 ), map_size_( 0 ), data_( 0 ), size_( 0 ), offset_( 0 )
+    {}
+
+    // map the whole file; flags: populate to prefault the pages, huge_pages to
+    // ask for transparent huge pages, both where supported:
+
+    gsl_api explicit mapped_file( char const * path, mode_type mode = read_only, int flags = no_flags )
+        : fd_( -1 ), mode_( mode ), flags_( flags ), file_size_( 0 )
+        , map_( 0 ), map_size_( 0 ), data_( 0 ), size_( 0 ), offset_( 0 )
+    {
+        open( path );
+        map_or_close( 0, file_size_ );
+    }
+
+    // map length bytes starting at offset of the file:
+
+    gsl_api mapped_file( char const * path, mode_type mode, size_t offset_in, size_t length, int flags = no_flags )
+        : fd_( -1 ), mode_( mode ), flags_( flags ), file_size_( 0 )
+        , map_( 0 ), map_size_( 0 ), data_( 0 ), size_( 0 ), offset_( 0 )
+    {
+        open( path );
+        map_or_close( offset_in, length );
+    }
+
+#if gsl_CPP11_OR_GREATER
+    gsl_api mapped_file( mapped_file && other ) gsl_noexcept
+        : mapped_file()
+    {
+        swap( other );
+    }
+
+    gsl_api mapped_file & operator=( mapped_file && other ) gsl_noexcept
+    {
+        mapped_file( std::move( other ) ).swap( *this );
+        return *this;
+    }
+
+    gsl_api mapped_file( mapped_file const & ) = delete;
+    gsl_api mapped_file & operator=( mapped_file const & ) = delete;
+#endif
+
+    gsl_api ~mapped_file()
+    {
+        unmap();
+
+        if ( fd_ >= 0 )
+            ::close( fd_ );
+    }
+
+    gsl_api void swap( mapped_file & other ) gsl_noexcept
+    {
+        using std::swap;
+        swap( fd_       , other.fd_        );
+        swap( mode_     , other.mode_      );
+        swap( flags_    , other.flags_     );
+        swap( file_size_, other.file_size_ );
+        swap( map_      , other.map_       );
+        swap( map_size_ , other.map_size_  );
+        swap( data_     , other.data_      );
+        swap( size_     , other.size_      );
+        swap( offset_   , other.offset_    );
+    }
+
+    // map length bytes starting at offset of the file instead of the current range:
+
+    gsl_api void remap( size_t offset_in, size_t length )
+    {
+        Expects( is_open() );
+        Expects( offset_in <= file_size_ && length <= file_size_ - offset_in );
+
+        unmap();
+
+        offset_ = offset_in;
+
+        if ( length == 0 )
+            return;
+
+        // mmap() requires an offset that is a multiple of the page size:
+
+        size_t const skip = offset_in % page_size();
+        int const protection = mode_ == read_write ? PROT_READ | PROT_WRITE : PROT_READ;
+        int map_flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+        if ( flags_ & populate )
+            map_flags |= MAP_POPULATE;
+#endif
+        void * const p = ::mmap( 0, length + skip, protection, map_flags, fd_, static_cast<off_t>( offset_in - skip ) );
+
+        if ( p == MAP_FAILED )
+            detail::throw_errno( "mapped_file: mmap" );
+
+        map_      = p;
+        map_size_ = length + skip;
+        data_     = static_cast<byte *>( p ) + skip;
+        size_     = length;
+#ifdef MADV_HUGEPAGE
+        if ( flags_ & huge_pages )
+            ::madvise( map_, map_size_, MADV_HUGEPAGE );
+#endif
+    }
+
+    // tell the system how the mapped range will be accessed; true if accepted:
+
+    gsl_api bool advise( advice_type advice ) const gsl_noexcept
+    {
+        if ( map_ == 0 )
+            return true;
+
+        int const advices[] = { POSIX_MADV_NORMAL, POSIX_MADV_SEQUENTIAL, POSIX_MADV_RANDOM, POSIX_MADV_WILLNEED, POSIX_MADV_DONTNEED, };
+
+        return 0 == ::posix_madvise( map_, map_size_, advices[ advice ] );
+    }
+
+    // write modified pages of a read-write mapping to the file:
+
+    gsl_api void flush()
+    {
+        Expects( mode_ == read_write );
+
+        if ( map_ && ::msync( map_, map_size_, MS_SYNC ) != 0 )
+            detail::throw_errno( "mapped_file: msync" );
+    }
+
+    gsl_api span<const byte> as_bytes() const gsl_noexcept
+    {
+        return span<const byte>( data_, size_ );
+    }
+
+    gsl_api span<byte> as_writeable_bytes()
+    {
+        Expects( mode_ == read_write );
+        return span<byte>( data_, size_ );
+    }
+
+    // the mapped range as U's, a trailing partial U is not included:
+
+    template< class U >
+    gsl_api span<const U> as_span() const
+    {
+        Expects( reinterpret_cast<size_t>( data_ ) % detail::alignment_of<U>::value == 0 );
+        return span<const U>( reinterpret_cast<U const *>( data_ ), size_ / sizeof( U ) );
+    }
+
+    template< class U >
+    gsl_api span<U> as_writeable_span()
+    {
+        Expects( mode_ == read_write );
+        Expects( reinterpret_cast<size_t>( data_ ) % detail::alignment_of<U>::value == 0 );
+        return span<U>( reinterpret_cast<U *>( data_ ), size_ / sizeof( U ) );
+    }
+
+    gsl_api bool is_open() const gsl_noexcept
+    {
+        return fd_ >= 0;
+    }
+
+    gsl_api mode_type mode() const gsl_noexcept
+    {
+        return mode_;
+    }
+
+    // size of the mapped range, its offset in the file and the size of the file:
+
+    gsl_api size_t size() const gsl_noexcept
+    {
+        return size_;
+    }
+
+    gsl_api bool empty() const gsl_noexcept
+    {
+        return size_ == 0;
+    }
+
+    gsl_api size_t offset() const gsl_noexcept
+    {
+        return offset_;
+    }
+
+    gsl_api size_t file_size() const gsl_noexcept
+    {
+        return file_size_;
+    }
+
+private:
+#if !gsl_CPP11_OR_GREATER
+    mapped_file( mapped_file const & );
+    mapped_file & operator=( mapped_file const & );
+#endif
+
+    static size_t page_size() gsl_noexcept
+    {
+        static const size_t size = static_cast<size_t>( ::sysconf( _SC_PAGESIZE ) );
+        return size;
+    }
+
+    void open( char const * path )
+    {
+        int oflags = mode_ == read_write ? O_RDWR : O_RDONLY;
+#ifdef O_CLOEXEC
+        oflags |= O_CLOEXEC;
+#endif
+        fd_ = ::open( path, oflags );
+
+        if ( fd_ < 0 )
+            detail::throw_errno( "mapped_file: open" );
+
+        struct stat status;
+
+        if ( ::fstat( fd_, &status ) != 0 )
+        {
+            close_preserving_errno();
+            detail::throw_errno( "mapped_file: fstat" );
+        }
+
+        file_size_ = static_cast<size_t>( status.st_size );
+    }
+
+    // the destructor does not run if a constructor throws:
+
+    void map_or_close( size_t offset_in, size_t length )
+    {
+        try
+        {
+            remap( offset_in, length );
+        }
+        catch ( ... )
+        {
+            close_preserving_errno();
+            throw;
+        }
+    }
+
+    void close_preserving_errno() gsl_noexcept
+    {
+        int const error = errno;
+        ::close( fd_ );
+        fd_ = -1;
+        errno = error;
+    }
+
+    void unmap() gsl_noexcept
+    {
+        if ( map_ )
+            ::munmap( map_, map_size_ );
+
+        map_ = 0;
+        map_size_ = 0;
+        data_ = 0;
+        size_ = 0;
+    }
+
+    int fd_;
+    mode_type mode_;
+    int flags_;
+    size_t file_size_;
+    void * map_;
+    size_t map_size_;
+    byte * data_;
+    size_t size_;
+    size_t offset_;
+};
+
+#endif // gsl_HAVE_MMAP
+
+#if gsl_HAVE_THREAD
+
+//
+// chunk_reader - Reads a stream in chunks into two or more aligned buffers in
+// turn. A background thread fills the next buffers while the caller parses
+// the current chunk:
+//
+//     chunk_reader reader( fd );
+//     size_t keep = 0;
+//     for ( span<const byte> chunk; !( chunk = reader.next( keep ) ).empty(); )
+//         keep = parse_records( chunk );  // returns the size of an incomplete last record
+//
+// next( keep ) returns the last keep bytes of the current chunk followed by
+// the bytes of the next buffer, contiguously. Only the kept tail is copied,
+// into room reserved in front of each buffer. An empty span marks the end
+// of the stream; bytes kept then are an incomplete last record. An
+// exception of the source is rethrown by next().
+//
+namespace detail {
+
+#if gsl_HAVE_MMAP
+
+// read from a file descriptor, retry when interrupted:
+
+struct fd_source
+{
+    explicit fd_source( int fd_ ) : fd( fd_ ) {}
+
+    size_t operator()( span<byte> buffer ) const
+    {
+        for ( ;; )
+        {
+            ssize_t const n = ::read( fd, buffer.data(), buffer.size() );
+
+            if ( n >= 0 )
+                return static_cast<size_t>( n );
+
+            if ( errno != EINTR )
+                throw_errno( "chunk_reader: read" );
+        }
+    }
+
+    int fd;
+};
+#endif
+} // namespace detail
+
+class chunk_reader
+{
+public:
+    // reads up to buffer.size() bytes into buffer, returns the number of bytes read, 0 at the end:
+
+    typedef std::function< size_t( span<byte> ) > source_type;
+
+    gsl_api explicit chunk_reader( source_type source, size_t chunk_size_in = 1024 * 1024, size_t max_tail_in = 64 * 1024, size_t buffer_count = 2, size_t alignment = 4096 )
+        : source_( std::move( source ) )
+        , chunk_size_( chunk_size_in )
+        , headroom_( headroom( max_tail_in, alignment ) )
+        , max_tail_( max_tail_in )
+        , alignment_( alignment )
+        , buffers_( buffer_count )
+        , storage_( 0 )
+        , current_( buffer_count )
+        , done_( false )
+        , stop_( false )
+    {
+        start();
+    }
+
+#if gsl_HAVE_MMAP
+    // read from a file or pipe, which must remain open while reading:
+
+    gsl_api explicit chunk_reader( int fd, size_t chunk_size_in = 1024 * 1024, size_t max_tail_in = 64 * 1024, size_t buffer_count = 2, size_t alignment = 4096 )
+        : source_( detail::fd_source( fd ) )
+        , chunk_size_( chunk_size_in )
+        , headroom_( headroom( max_tail_in, alignment ) )
+        , max_tail_( max_tail_in )
+        , alignment_( alignment )
+        , buffers_( buffer_count )
+        , storage_( 0 )
+        , current_( buffer_count )
+        , done_( false )
+        , stop_( false )
+    {
+        start();
+    }
+#endif
+
+    chunk_reader( chunk_reader const & ) = delete;
+    chunk_reader & operator=( chunk_reader const & ) = delete;
+
+    // waits for a pending read of the source to complete:
+
+    gsl_api ~chunk_reader()
+    {
+        {
+            std::lock_guard<std::mutex> lock( mutex_ );
+            stop_ = true;
+        }
+        changed_.notify_all();
+        filler_.join();
+
+        detail::aligned_deallocate( storage_, alignment_ );
+    }
+
+    // the last keep bytes of the current chunk followed by the next chunk read:
+
+    gsl_api span<const byte> next( size_t keep = 0 )
+    {
+        Expects( keep <= max_tail_ );
+        Expects( keep <= tail_.size() );
+
+        size_t const next = current_ == buffers_.size() ? 0 : ( current_ + 1 ) % buffers_.size();
+
+        std::unique_lock<std::mutex> lock( mutex_ );
+
+        while ( buffers_[ next ].state != ready && !done_ )
+            changed_.wait( lock );
+
+        if ( buffers_[ next ].state != ready )
+        {
+            tail_ = span<const byte>();
+
+            if ( error_ )
+                std::rethrow_exception( error_ );
+
+            return span<const byte>();
+        }
+
+        byte * const data = data_of( next );
+        size_t const size = buffers_[ next ].size;
+
+        lock.unlock();
+
+        if ( keep > 0 )
+            std::memcpy( data - keep, tail_.data() + tail_.size() - keep, keep );
+
+        release( current_ );
+        current_ = next;
+        tail_ = span<const byte>( data - keep, keep + size );
+
+        return tail_;
+    }
+
+    gsl_api size_t chunk_size() const gsl_noexcept
+    {
+        return chunk_size_;
+    }
+
+    gsl_api size_t max_tail() const gsl_noexcept
+    {
+        return max_tail_;
+    }
+
+private:
+    // a buffer is ready from being filled until the chunk after it is taken:
+
+    enum state_type { empty, ready };
+
+    struct buffer
+    {
+        buffer() : state( empty ), size( 0 ) {}
+
+        state_type state;
+        size_t size;
+    };
+
+    // room for the tail before a chunk, checked before the alignment divides:
+
+    static size_t headroom( size_t max_tail, size_t alignment )
+    {
+        Expects( alignment > 0 && ( alignment & ( alignment - 1 ) ) == 0 );
+
+        return ( max_tail + alignment - 1 ) / alignment * alignment;
+    }
+
+    size_t stride() const gsl_noexcept
+    {
+        return headroom_ + ( chunk_size_ + alignment_ - 1 ) / alignment_ * alignment_;
+    }
+
+    byte * data_of( size_t index ) const gsl_noexcept
+    {
+        return static_cast<byte *>( storage_ ) + index * stride() + headroom_;
+    }
+
+    void start()
+    {
+        Expects( chunk_size_ > 0 );
+        Expects( buffers_.size() >= 2 );
+
+        if ( buffers_.size() > std::numeric_limits<size_t>::max() / stride() )
+            throw std::bad_alloc();
+
+        storage_ = detail::aligned_allocate( buffers_.size() * stride(), alignment_ );
+
+        try
+        {
+            filler_ = std::thread( &chunk_reader::fill, this );
+        }
+        catch ( ... )
+        {
+            detail::aligned_deallocate( storage_, alignment_ );
+            throw;
+        }
+    }
+
+    void release( size_t index )
+    {
+        if ( index == buffers_.size() )
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock( mutex_ );
+            buffers_[ index ].state = empty;
+        }
+        changed_.notify_all();
+    }
+
+    // background thread: fill the buffers in turn until the end of the source:
+
+    void fill()
+    {
+        for ( size_t i = 0; ; i = ( i + 1 ) % buffers_.size() )
+        {
+            {
+                std::unique_lock<std::mutex> lock( mutex_ );
+
+                while ( buffers_[ i ].state != empty && !stop_ )
+                    changed_.wait( lock );
+
+                if ( stop_ )
+                    return;
+            }
+
+            size_t size = 0;
+            bool end = false;
+            std::exception_ptr error;
+
+            try
+            {
+                while ( size < chunk_size_ && !end )
+                {
+                    size_t const n = source_( span<byte>( data_of( i ) + size, chunk_size_ - size ) );
+
+                    end = n == 0;
+                    size += n;
+                }
+            }
+            catch ( ... )
+            {
+                error = std::current_exception();
+                end = true;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock( mutex_ );
+
+                if ( size > 0 )
+                {
+                    buffers_[ i ].state = ready;
+                    buffers_[ i ].size = size;
+                }
+                done_ = end;
+                error_ = error;
+            }
+            changed_.notify_all();
+
+            if ( end )
+                return;
+        }
+    }
+
+    source_type source_;
+    size_t const chunk_size_;
+    size_t const headroom_;
+    size_t const max_tail_;
+    size_t const alignment_;
+    std::vector< buffer > buffers_;
+    void * storage_;
+    size_t current_;            // buffers_.size() before the first chunk
+    span<const byte> tail_;     // the current chunk
+    bool done_;
+    bool stop_;
+    std::exception_ptr error_;
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    std::thread filler_;
+};
+
+#endif // gsl_HAVE_THREAD
+
+#if gsl_HAVE_UIO
+
+//
+// span_sequence<> - Up to N byte ranges of spans, laid out as struct iovec for
+// scatter/gather I/O with readv() and writev() (POSIX):
+//
+//     span_sequence<3> message;
+//     message.push_back( header ).push_back( body ).push_back( trailer );
+//     write_spans( fd, message );
+//
+// write_spans() and read_spans() transfer the bytes without copying them and
+// continue after a partial transfer from where it ended: the sequence is
+// advanced past the bytes transferred, so that it holds what remains. N
+// should not exceed IOV_MAX.
+//
+template< size_t N >
+class span_sequence
+{
+public:
+    static const size_t max_size = N;
+
+    gsl_api span_sequence() gsl_noexcept
+        : first_( 0 ), count_( 0 ), writeable_( true )
+    {}
+
+    // append the bytes of a span; a sequence with a span of const elements
+    // can only be written from:
+
+    template< class T >
+    gsl_api span_sequence & push_back( span<T> s )
+    {
+        Expects( count_ < N );
+
+        iov_[ count_ ].iov_base = const_cast<void *>( static_cast<void const *>( s.data() ) );
+        iov_[ count_ ].iov_len  = s.bytes();
+        ++count_;
+        writeable_ = writeable_ && !detail::is_const<T>::value;
+
+        return *this;
+    }
+
+    // drop the first n bytes:
+
+    gsl_api void advance( size_t n )
+    {
+        Expects( n <= size_bytes() );
+
+        for ( ; n > 0 && n >= iov_[ first_ ].iov_len; ++first_ )
+            n -= iov_[ first_ ].iov_len;
+
+        // skip empty ranges, so that a non-empty sequence starts with a non-empty range:
+
+        while ( first_ < count_ && iov_[ first_ ].iov_len == 0 )
+            ++first_;
+
+        if ( n > 0 )
+        {
+            iov_[ first_ ].iov_base = static_cast<char *>( iov_[ first_ ].iov_base ) + n;
+            iov_[ first_ ].iov_len -= n;
+        }
+    }
+
+    gsl_api void clear() gsl_noexcept
+    {
+        first_ = count_ = 0;
+        writeable_ = true;
+    }
+
+    // the remaining ranges as iovec's:
+
+    gsl_api struct iovec const * data() const gsl_noexcept
+    {
+        return iov_ + first_;
+    }
+
+    gsl_api struct iovec * data() gsl_noexcept
+    {
+        return iov_ + first_;
+    }
+
+    gsl_api size_t size() const gsl_noexcept
+    {
+        return count_ - first_;
+    }
+
+    gsl_api size_t size_bytes() const gsl_noexcept
+    {
+        size_t result = 0;
+        for ( size_t i = first_; i < count_; ++i )
+            result += iov_[i].iov_len;
+        return result;
+    }
+
+    gsl_api bool empty() const gsl_noexcept
+    {
+        return size_bytes() == 0;
+    }
+
+    gsl_api bool is_writeable() const gsl_noexcept
+    {
+        return writeable_;
+    }
+
+private:
+    struct iovec iov_[ N ];
+    size_t first_;
+    size_t count_;
+    bool writeable_;
+};
+
+// write all bytes of the sequence with writev(), retry when interrupted; return
+// the number of bytes written, which is less if a non-blocking fd would block:
+
+template< size_t N >
+gsl_api size_t write_spans( int fd, span_sequence<N> & spans )
+{
+    size_t total = 0;
+
+    while ( !spans.empty() )
+    {
+        ssize_t const n = ::writev( fd, spans.data(), static_cast<int>( spans.size() ) );
+
+        if ( n < 0 )
+        {
+            if ( errno == EINTR )
+                continue;
+            if ( errno == EAGAIN || errno == EWOULDBLOCK )
+                break;
+            detail::throw_errno( "write_spans: writev" );
+        }
+
+        spans.advance( static_cast<size_t>( n ) );
+        total += static_cast<size_t>( n );
+    }
+    return total;
+}
+
+// fill the sequence with readv(), retry when interrupted; return the number of
+// bytes read, which is less at end of file or if a non-blocking fd would block:
+
+template< size_t N >
+gsl_api size_t read_spans( int fd, span_sequence<N> & spans )
+{
+    Expects( spans.is_writeable() );
+
+    size_t total = 0;
+
+    while ( !spans.empty() )
+    {
+        ssize_t const n = ::readv( fd, spans.data(), static_cast<int>( spans.size() ) );
+
+        if ( n < 0 )
+        {
+            if ( errno == EINTR )
+                continue;
+            if ( errno == EAGAIN || errno == EWOULDBLOCK )
+                break;
+            detail::throw_errno( "read_spans: readv" );
+        }
+
+        if ( n == 0 )
+            break;
+
+        spans.advance( static_cast<size_t>( n ) );
+        total += static_cast<size_t>( n );
+    }
+    return total;
+}
+
+#endif // gsl_HAVE_UIO
+
+#if gsl_HAVE_THREAD
+
+//
+// spsc_ring<> - A lock-free ring buffer for one producer and one consumer
+// thread. Both transfer elements in batches, directly in the ring's memory:
+//
+//     ring_regions<sample> r = ring.reserve( 64 );         // producer
+//     size_t n = fill( r.first ) + fill( r.second );
+//     ring.commit( n );
+//
+//     ring_regions<const sample> s = ring.peek();           // consumer
+//     process( s.first ); process( s.second );
+//     ring.release( s.size() );
+//
+// A region consists of two spans, as it may wrap around the end of the
+// memory; the second span is empty if it does not. Only commit() and
+// release() publish an index. Each side keeps its index on a cache line of
+// its own, along with the last index it loaded of the other side.
+//
+namespace detail {
+
+// the size of a cache line, to keep data of different threads apart:
+
+const size_t cache_line_size = 64;
+} // namespace detail
+
+template< class T >
+struct ring_regions
+{
+    span<T> first;
+    span<T> second;
+
+    gsl_api size_t size() const gsl_noexcept
+    {
+        return first.size() + second.size();
+    }
+
+    gsl_api bool empty() const gsl_noexcept
+    {
+        return size() == 0;
+    }
+};
+
+template< class T >
+class spsc_ring
+{
+public:
+    typedef T value_type;
+
+    // capacity_in value-initialized elements, rounded up to a power of two:
+
+    gsl_api explicit spsc_ring( size_t capacity_in )
+        : elements_( round_up( capacity_in ) )
+        , mask_( elements_.size() - 1 )
+    {}
+
+    gsl_api spsc_ring( spsc_ring const & ) = delete;
+    gsl_api spsc_ring & operator=( spsc_ring const & ) = delete;
+
+    // producer: up to n free elements to assign to:
+
+    gsl_api ring_regions<T> reserve( size_t n = size_t( -1 ) ) gsl_noexcept
+    {
+        size_t const head = producer_.head.load( std::memory_order_relaxed );
+
+        if ( capacity() - ( head - producer_.tail ) < n )
+            producer_.tail = consumer_.tail.load( std::memory_order_acquire );
+
+        producer_.reserved = (std::min)( n, capacity() - ( head - producer_.tail ) );
+
+        return regions<T>( head, producer_.reserved );
+    }
+
+    // producer: publish the first n reserved elements:
+
+    gsl_api void commit( size_t n )
+    {
+        Expects( n <= producer_.reserved );
+
+        producer_.reserved -= n;
+        producer_.head.store( producer_.head.load( std::memory_order_relaxed ) + n, std::memory_order_release );
+    }
+
+    gsl_api bool try_push( T const & value )
+    {
+        ring_regions<T> const r = reserve( 1 );
+
+        if ( r.empty() )
+            return false;
+
+        r.first[0] = value;
+        commit( 1 );
+        return true;
+    }
+
+    // consumer: up to n published elements:
+
+    gsl_api ring_regions<const T> peek( size_t n = size_t( -1 ) ) gsl_noexcept
+    {
+        size_t const tail = consumer_.tail.load( std::memory_order_relaxed );
+
+        if ( consumer_.head - tail < n )
+            consumer_.head = producer_.head.load( std::memory_order_acquire );
+
+        consumer_.peeked = (std::min)( n, consumer_.head - tail );
+
+        return regions<const T>( tail, consumer_.peeked );
+    }
+
+    // consumer: free the first n peeked elements for reuse:
+
+    gsl_api void release( size_t n )
+    {
+        Expects( n <= consumer_.peeked );
+
+        consumer_.peeked -= n;
+        consumer_.tail.store( consumer_.tail.load( std::memory_order_relaxed ) + n, std::memory_order_release );
+    }
+
+    gsl_api bool try_pop( T & value )
+    {
+        ring_regions<const T> const r = peek( 1 );
+
+        if ( r.empty() )
+            return false;
+
+        value = r.first[0];
+        release( 1 );
+        return true;
+    }
+
+    gsl_api size_t capacity() const gsl_noexcept
+    {
+        return mask_ + 1;
+    }
+
+    // the number of published elements, exact if neither side is active:
+
+    gsl_api size_t size() const gsl_noexcept
+    {
+        size_t const tail = consumer_.tail.load( std::memory_order_acquire );
+        return producer_.head.load( std::memory_order_acquire ) - tail;
+    }
+
+    gsl_api bool empty() const gsl_noexcept
+    {
+        return size() == 0;
+    }
+
+private:
+    // the indices count elements ever transferred, an element's position is
+    // its index modulo the capacity:
+
+    struct alignas( detail::cache_line_size ) producer_side
+    {
+        producer_side() : head( 0 ), tail( 0 ), reserved( 0 ) {}
+
+        std::atomic<size_t> head;
+        size_t tail;                // last loaded from the consumer
+        size_t reserved;
+    };
+
+    struct alignas( detail::cache_line_size ) consumer_side
+    {
+        consumer_side() : tail( 0 ), head( 0 ), peeked( 0 ) {}
+
+        std::atomic<size_t> tail;
+        size_t head;                // last loaded from the producer
+        size_t peeked;
+    };
+
+    static size_t round_up( size_t n )
+    {
+        Expects( n > 0 && n <= ( size_t( -1 ) >> 1 ) + 1 );
+
+        size_t result = 1;
+        while ( result < n )
+            result <<= 1;
+        return result;
+    }
+
+    template< class U >
+    ring_regions<U> regions( size_t index, size_t n ) gsl_noexcept
+    {
+        size_t const begin = index & mask_;
+        size_t const first = (std::min)( n, capacity() - begin );
+
+        ring_regions<U> result;
+        result.first  = span<U>( elements_.data() + begin, first );
+        result.second = span<U>( elements_.data(), n - first );
+        return result;
+    }
+
+    dyn_array<T> elements_;
+    size_t const mask_;
+    producer_side producer_;
+    consumer_side consumer_;
+};
+
+#endif // gsl_HAVE_THREAD
+
+#if gsl_HAVE_MMAP
+
+//
+// mirrored_ring - A ring buffer of bytes whose memory is mapped twice, back to
+// back, so that the readable and the writeable region are each one contiguous
+// span, also where they wrap around the end of the ring (POSIX):
+//
+//     mirrored_ring ring( 64 * 1024 );
+//     ring.commit( read( fd, ring.writeable() ) );
+//     ring.consume( parse( ring.readable() ) );   // returns the bytes parsed
+//
+// The capacity is a multiple of the page size. The memory is a memfd on Linux
+// and an unlinked temporary file elsewhere. The ring is not synchronized.
+// Failure to create the mappings throws std::system_error (C++11) or
+// std::runtime_error.
+//
+class mirrored_ring
+{
+public:
+    // at least capacity_in bytes, rounded up to a multiple of the page size:
+
+    gsl_api explicit mirrored_ring( size_t capacity_in )
+        : data_( 0 ), capacity_( round_up( capacity_in ) ), begin_( 0 ), size_( 0 )
+    {
+        map();
+    }
+
+#if gsl_CPP11_OR_GREATER
+    gsl_api mirrored_ring( mirrored_ring && other ) gsl_noexcept
+        : data_( nullptr ), capacity_( 0 ), begin_( 0 ), size_( 0 )
+    {
+        swap( other );
+    }
+
+    gsl_api mirrored_ring & operator=( mirrored_ring && other ) gsl_noexcept
+    {
+        mirrored_ring( std::move( other ) ).swap( *this );
+        return *this;
+    }
+
+    gsl_api mirrored_ring( mirrored_ring const & ) = delete;
+    gsl_api mirrored_ring & operator=( mirrored_ring const & ) = delete;
+#endif
+
+    gsl_api ~mirrored_ring()
+    {
+        if ( data_ )
+            ::munmap( data_, 2 * capacity_ );
+    }
+
+    gsl_api void swap( mirrored_ring & other ) gsl_noexcept
+    {
+        using std::swap;
+        swap( data_    , other.data_     );
+        swap( capacity_, other.capacity_ );
+        swap( begin_   , other.begin_    );
+        swap( size_    , other.size_     );
+    }
+
+    // the bytes written and not yet consumed:
+
+    gsl_api span<const byte> readable() const gsl_noexcept
+    {
+        return span<const byte>( data_ + begin_, size_ );
+    }
+
+    // the free bytes following the readable ones:
+
+    gsl_api span<byte> writeable() gsl_noexcept
+    {
+        return span<byte>( data_ + begin_ + size_, capacity_ - size_ );
+    }
+
+    // make the first n writeable bytes readable:
+
+    gsl_api void commit( size_t n )
+    {
+        Expects( n <= capacity_ - size_ );
+        size_ += n;
+    }
+
+    // free the first n readable bytes:
+
+    gsl_api void consume( size_t n )
+    {
+        Expects( n <= size_ );
+
+        begin_ += n;
+        size_  -= n;
+
+        if ( begin_ >= capacity_ )
+            begin_ -= capacity_;
+    }
+
+    gsl_api void clear() gsl_noexcept
+    {
+        begin_ = size_ = 0;
+    }
+
+    gsl_api size_t capacity() const gsl_noexcept
+    {
+        return capacity_;
+    }
+
+    gsl_api size_t size() const gsl_noexcept
+    {
+        return size_;
+    }
+
+    gsl_api bool empty() const gsl_noexcept
+    {
+        return size_ == 0;
+    }
+
+    gsl_api bool full() const gsl_noexcept
+    {
+        return size_ == capacity_;
+    }
+
+private:
+#if !gsl_CPP11_OR_GREATER
+    mirrored_ring( mirrored_ring const & );
+    mirrored_ring & operator=( mirrored_ring const & );
+#endif
+
+    static size_t round_up( size_t n )
+    {
+        size_t const page = static_cast<size_t>( ::sysconf( _SC_PAGESIZE ) );
+
+        Expects( n > 0 && n <= ( size_t( -1 ) >> 2 ) );
+
+        return ( n + page - 1 ) / page * page;
+    }
+
+    static int open_memory()
+    {
+#if defined(__linux__) && defined(MFD_CLOEXEC)
+        return ::memfd_create( "gsl-lite-mirrored-ring", MFD_CLOEXEC );
+#else
+        char name[] = "/tmp/gsl-lite-mirrored-ring-XXXXXX";
+        int const fd = ::mkstemp( name );
+        if ( fd >= 0 )
+            ::unlink( name );
+        return fd;
+#endif
+    }
+
+    // reserve twice the capacity of address space, then map the memory into
+    // both halves:
+
+    void map()
+    {
+        int const fd = open_memory();
+
+        if ( fd < 0 )
+            detail::throw_errno( "mirrored_ring: memfd_create" );
+
+        if ( ::ftruncate( fd, static_cast<off_t>( capacity_ ) ) != 0 )
+            close_and_throw( fd, "mirrored_ring: ftruncate" );
+
+#if defined(MAP_ANONYMOUS)
+        int const anonymous = MAP_ANONYMOUS;
+#else
+        int const anonymous = MAP_ANON;
+#endif
+        void * const p = ::mmap( 0, 2 * capacity_, PROT_NONE, MAP_PRIVATE | anonymous, -1, 0 );
+
+        if ( p == MAP_FAILED )
+            close_and_throw( fd, "mirrored_ring: mmap" );
+
+        data_ = static_cast<byte *>( p );
+
+        for ( int half = 0; half < 2; ++half )
+        {
+            void * const q = ::mmap( data_ + half * capacity_, capacity_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0 );
+
+            if ( q == MAP_FAILED )
+            {
+                int const error = errno;
+                ::munmap( data_, 2 * capacity_ );
+                data_ = 0;
+                errno = error;
+                close_and_throw( fd, "mirrored_ring: mmap" );
+            }
+        }
+
+        // the mappings keep the memory alive:
+
+        ::close( fd );
+    }
+
+    static void close_and_throw( int fd, char const * what )
+    {
+        int const error = errno;
+        ::close( fd );
+        errno = error;
+        detail::throw_errno( what );
+    }
+
+    byte * data_;
+    size_t capacity_;
+    size_t begin_;
+    size_t size_;
+};
+
+#endif // gsl_HAVE_MMAP
+
+#if gsl_HAVE_THREAD
+
+//
+// thread_pool - Worker threads that run the chunks of a parallel loop, with the
+// calling thread participating. Each participant starts with an equal share of
+// the chunks and takes them from the front; once its share is done, it steals
+// the back half of the share of another participant:
+//
+//     thread_pool pool;                                    // hardware threads - 1 workers
+//     pool.run( count, []( size_t chunk, size_t participant ){ ... } );
+//
+// run() returns when all chunks are done and rethrows the first exception of a
+// chunk; the chunks not yet started are then skipped. A run() from within a
+// chunk runs its chunks on the calling thread.
+//
+// parallel_for_each(), parallel_transform() and parallel_reduce() split a span
+// into chunks that start at a cache line, except the first, and run them on a
+// pool, by default on default_thread_pool():
+//
+//     parallel_transform( span<const float>( in ), span<float>( out ), []( float x ){ return x * x; } );
+//     double sum = parallel_reduce( span<const float>( in ), 0.0, std::plus<double>() );
+//     double det = parallel_reduce( span<const float>( in ), 0.0, std::plus<double>(), in_order );
+//
+// Without a grain size, a chunk holds at least 16 kB and there are about
+// four chunks per participant. parallel_reduce() requires op to be
+// associative and commutative; with in_order it combines the results of the
+// chunks from left to right, so that op only needs to be associative. These
+// chunks start at the first element and hold grain elements, by default 16 kB,
+// so that the result only depends on the elements, init, op and grain, not on
+// the pool, the scheduling or the alignment of the span.
+//
+namespace detail {
+
+const size_t parallel_min_chunk_bytes = 16 * 1024;
+const size_t parallel_chunks_per_participant = 4;
+
+// a range of chunk indices, begin and end in one atomic word, so that the
+// owner can take chunks from the front while others steal from the back:
+
+struct alignas( cache_line_size ) chunk_range
+{
+    chunk_range() : bits( 0 ) {}
+
+    void assign( size_t begin, size_t end ) gsl_noexcept
+    {
+        bits.store( pack( begin, end ), std::memory_order_relaxed );
+    }
+
+    bool pop_front( size_t & index ) gsl_noexcept
+    {
+        unsigned long long v = bits.load( std::memory_order_relaxed );
+
+        while ( first( v ) < last( v ) )
+        {
+            if ( bits.compare_exchange_weak( v, pack( first( v ) + 1, last( v ) ), std::memory_order_relaxed ) )
+            {
+                index = first( v );
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // take the back half, or the last chunk:
+
+    bool steal_back( size_t & begin, size_t & end ) gsl_noexcept
+    {
+        unsigned long long v = bits.load( std::memory_order_relaxed );
+
+        while ( first( v ) < last( v ) )
+        {
+            size_t const middle = first( v ) + ( last( v ) - first( v ) ) / 2;
+
+            if ( bits.compare_exchange_weak( v, pack( first( v ), middle ), std::memory_order_relaxed ) )
+            {
+                begin = middle;
+                end   = last( v );
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static unsigned long long pack( size_t begin, size_t end ) gsl_noexcept
+    {
+        return static_cast<unsigned long long>( begin ) << 32 | end;
+    }
+
+    static size_t first( unsigned long long v ) gsl_noexcept
+    {
+        return static_cast<size_t>( v >> 32 );
+    }
+
+    static size_t last( unsigned long long v ) gsl_noexcept
+    {
+        return static_cast<size_t>( v & 0xffffffffu );
+    }
+
+    std::atomic<unsigned long long> bits;
+};
+
+// whether the current thread runs a chunk of a thread_pool:
+
+inline bool & in_thread_pool() gsl_noexcept
+{
+    static thread_local bool flag = false;
+    return flag;
+}
+} // namespace detail
+
+class thread_pool
+{
+public:
+    // the default number of workers: the hardware threads besides the caller:
+
+    static size_t default_workers() gsl_noexcept
+    {
+        unsigned const n = std::thread::hardware_concurrency();
+        return n > 1 ? n - 1 : 0;
+    }
+
+    gsl_api explicit thread_pool( size_t workers = default_workers() )
+        : ranges_( workers + 1 ), call_( nullptr ), task_( nullptr )
+        , generation_( 0 ), running_( 0 ), stop_( false ), cancelled_( false )
+    {
+        try
+        {
+            for ( size_t i = 0; i < workers; ++i )
+                workers_.push_back( std::thread( &thread_pool::work, this, i + 1 ) );
+        }
+        catch ( ... )
+        {
+            stop();
+            throw;
+        }
+    }
+
+    gsl_api thread_pool( thread_pool const & ) = delete;
+    gsl_api thread_pool & operator=( thread_pool const & ) = delete;
+
+    gsl_api ~thread_pool()
+    {
+        stop();
+    }
+
+    // the number of participants in a run(): the workers and the caller:
+
+    gsl_api size_t concurrency() const gsl_noexcept
+    {
+        return workers_.size() + 1;
+    }
+
+    // call task( chunk, participant ) for each chunk in [0, count), where
+    // participant < concurrency() identifies the thread:
+
+    template< class F >
+    gsl_api void run( size_t count, F const & task )
+    {
+        Expects( count <= 0xffffffffu );
+
+        if ( count == 0 )
+            return;
+
+        if ( count == 1 || workers_.empty() || detail::in_thread_pool() )
+        {
+            for ( size_t i = 0; i < count; ++i )
+                task( i, 0 );
+            return;
+        }
+
+        std::lock_guard<std::mutex> serialize( run_mutex_ );
+
+        size_t const n = concurrency();
+
+        for ( size_t p = 0; p < n; ++p )
+            ranges_[p].assign( count * p / n, count * ( p + 1 ) / n );
+
+        {
+            std::lock_guard<std::mutex> lock( mutex_ );
+            call_ = &call<F>;
+            task_ = &task;
+            error_ = nullptr;
+            cancelled_.store( false, std::memory_order_relaxed );
+            running_ = workers_.size();
+            ++generation_;
+        }
+        wake_.notify_all();
+
+        participate( 0 );
+
+        std::exception_ptr error;
+        {
+            std::unique_lock<std::mutex> lock( mutex_ );
+            done_.wait( lock, [this]{ return running_ == 0; } );
+            std::swap( error, error_ );
+        }
+
+        if ( error )
+            std::rethrow_exception( error );
+    }
+
+private:
+    template< class F >
+    static void call( void const * task, size_t chunk, size_t participant )
+    {
+        ( *static_cast<F const *>( task ) )( chunk, participant );
+    }
+
+    void work( size_t participant )
+    {
+        detail::in_thread_pool() = true;
+
+        for ( unsigned long long seen = 0; ; )
+        {
+            {
+                std::unique_lock<std::mutex> lock( mutex_ );
+                wake_.wait( lock, [&]{ return stop_ || generation_ != seen; } );
+
+                if ( stop_ )
+                    return;
+
+                seen = generation_;
+            }
+
+            participate( participant );
+
+            std::lock_guard<std::mutex> lock( mutex_ );
+
+            if ( --running_ == 0 )
+                done_.notify_one();
+        }
+    }
+
+    void participate( size_t participant )
+    {
+        bool const was_in_pool = detail::in_thread_pool();
+        detail::in_thread_pool() = true;
+
+        for ( size_t chunk; ranges_[ participant ].pop_front( chunk ) || steal( participant, chunk ); )
+        {
+            if ( cancelled_.load( std::memory_order_relaxed ) )
+                continue;
+
+            try
+            {
+                call_( task_, chunk, participant );
+            }
+            catch ( ... )
+            {
+                std::lock_guard<std::mutex> lock( mutex_ );
+
+                if ( !error_ )
+                    error_ = std::current_exception();
+
+                cancelled_.store( true, std::memory_order_relaxed );
+            }
+        }
+
+        detail::in_thread_pool() = was_in_pool;
+    }
+
+    // take chunks of another participant, return the first of them:
+
+    bool steal( size_t participant, size_t & chunk ) gsl_noexcept
+    {
+        size_t const n = ranges_.size();
+
+        for ( size_t k = 1; k < n; ++k )
+        {
+            size_t begin, end;
+
+            if ( ranges_[ ( participant + k ) % n ].steal_back( begin, end ) )
+            {
+                ranges_[ participant ].assign( begin + 1, end );
+                chunk = begin;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void stop() gsl_noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock( mutex_ );
+            stop_ = true;
+        }
+        wake_.notify_all();
+
+        for ( size_t i = 0; i < workers_.size(); ++i )
+            workers_[i].join();
+    }
+
+    dyn_array<detail::chunk_range> ranges_;
+    std::vector<std::thread> workers_;
+    void ( * call_ )( void const *, size_t, size_t );
+    void const * task_;
+    unsigned long long generation_;
+    size_t running_;                        // workers yet to finish the current run
+    bool stop_;
+    std::atomic<bool> cancelled_;
+    std::exception_ptr error_;
+    std::mutex run_mutex_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+};
+
+// the pool used by the parallel algorithms without a pool argument:
+
+gsl_api inline thread_pool & default_thread_pool()
+{
+    static thread_pool pool;
+    return pool;
+}
+
+// tag to combine the results of parallel_reduce() in the order of the chunks:
+
+struct in_order_t{ gsl_constexpr14 in_order_t(){} };
+const in_order_t in_order;
+
+namespace detail {
+
+// a span split into chunks for a thread_pool: the first chunk ends before a
+// cache line, further chunks hold a multiple of the elements in a cache line:
+
+template< class T >
+class span_chunks
+{
+public:
+    span_chunks( span<T> s, size_t grain, size_t concurrency )
+        : span_( s ), first_( 0 ), size_( 1 )
+    {
+        size_t const n = s.size();
+
+        if ( grain == 0 )
+        {
+            size_t const chunks = parallel_chunks_per_participant * concurrency;
+            grain = ( std::max )( parallel_min_chunk_bytes / sizeof( T ), ( n + chunks - 1 ) / chunks );
+        }
+
+        size_t line = 1, head = 0;
+
+        if ( sizeof( T ) < cache_line_size && cache_line_size % sizeof( T ) == 0 )
+        {
+            size_t const offset = reinterpret_cast<size_t>( s.data() ) % cache_line_size;
+            line = cache_line_size / sizeof( T );
+            head = ( cache_line_size - offset ) % cache_line_size / sizeof( T );
+        }
+
+        size_  = ( ( std::max )( grain, size_t( 1 ) ) + line - 1 ) / line * line;
+        first_ = head + size_;
+    }
+
+    // chunks of size elements from the first element on, by default of 16 kB:
+
+    span_chunks( span<T> s, size_t size )
+        : span_( s ), first_( 0 ), size_( 1 )
+    {
+        if ( size == 0 )
+            size = parallel_min_chunk_bytes / sizeof( T );
+
+        size_  = ( std::max )( size, size_t( 1 ) );
+        first_ = size_;
+    }
+
+    size_t count() const gsl_noexcept
+    {
+        size_t const n = span_.size();
+
+        return n == 0 ? 0 : n <= first_ ? 1 : 1 + ( n - first_ + size_ - 1 ) / size_;
+    }
+
+    span<T> operator[]( size_t i ) const
+    {
+        size_t const n     = span_.size();
+        size_t const begin = i == 0 ? 0 : first_ + ( i - 1 ) * size_;
+        size_t const end   = (std::min)( n, first_ + i * size_ );
+
+        return span_.subspan( begin, end - begin );
+    }
+
+private:
+    span<T> span_;
+    size_t first_;
+    size_t size_;
+};
+
+// the result of a participant or chunk in parallel_reduce(), on a cache line of its own:
+
+template< class R >
+struct alignas( cache_line_size ) partial_result
+{
+    explicit partial_result( R const & value_ ) : value( value_ ), valid( false ) {}
+
+    R value;
+    bool valid;
+};
+
+template< class T, class R, class Op >
+R reduce_chunk( span<T> chunk, Op & op )
+{
+    T *       pos = chunk.data();
+    T * const end = pos + chunk.size();
+
+    R result( *pos );
+
+    for ( ++pos; pos != end; ++pos )
+        result = op( result, *pos );
+
+    return result;
+}
+} // namespace detail
+
+// call f( x ) for each element:
+
+template< class T, class F >
+gsl_api void parallel_for_each( thread_pool & pool, span<T> s, F f, size_t grain = 0 )
+{
+    detail::span_chunks<T> const chunks( s, grain, pool.concurrency() );
+
+    pool.run( chunks.count(), [&]( size_t i, size_t )
+    {
+        span<T> const chunk = chunks[i];
+        T * const end = chunk.data() + chunk.size();
+
+        for ( T * pos = chunk.data(); pos != end; ++pos )
+            f( *pos );
+    } );
+}
+
+template< class T, class F >
+gsl_api void parallel_for_each( span<T> s, F f, size_t grain = 0 )
+{
+    parallel_for_each( default_thread_pool(), s, f, grain );
+}
+
+// assign f( in[i] ) to out[i]; chunks are aligned to the output:
+
+template< class T, class U, class F >
+gsl_api void parallel_transform( thread_pool & pool, span<T> in, span<U> out, F f, size_t grain = 0 )
+{
+    Expects( in.size() == out.size() );
+
+    detail::span_chunks<U> const chunks( out, grain, pool.concurrency() );
+
+    pool.run( chunks.count(), [&]( size_t i, size_t )
+    {
+        span<U> const chunk = chunks[i];
+        T * const source = in.data() + ( chunk.data() - out.data() );
+        U * const target = chunk.data();
+
+        for ( size_t k = 0; k < chunk.size(); ++k )
+            target[k] = f( source[k] );
+    } );
+}
+
+template< class T, class U, class F >
+gsl_api void parallel_transform( span<T> in, span<U> out, F f, size_t grain = 0 )
+{
+    parallel_transform( default_thread_pool(), in, out, f, grain );
+}
+
+// init combined with all elements by op, in any order:
+
+template< class T, class R, class Op >
+gsl_api R parallel_reduce( thread_pool & pool, span<T> s, R init, Op op, size_t grain = 0 )
+{
+    detail::span_chunks<T> const chunks( s, grain, pool.concurrency() );
+    dyn_array< detail::partial_result<R> > partials( pool.concurrency(), detail::partial_result<R>( init ) );
+
+    pool.run( chunks.count(), [&]( size_t i, size_t participant )
+    {
+        detail::partial_result<R> & partial = partials[ participant ];
+        R const result = detail::reduce_chunk<T, R>( chunks[i], op );
+
+        partial.value = partial.valid ? op( partial.value, result ) : result;
+        partial.valid = true;
+    } );
+
+    for ( size_t p = 0; p < partials.size(); ++p )
+    {
+        if ( partials[p].valid )
+            init = op( init, partials[p].value );
+    }
+    return init;
+}
+
+template< class T, class R, class Op >
+gsl_api R parallel_reduce( span<T> s, R init, Op op, size_t grain = 0 )
+{
+    return parallel_reduce( default_thread_pool(), s, init, op, grain );
+}
+
+// init combined with the elements by op from left to right, as far as
+// associativity allows; the chunks only depend on grain and sizeof( T ):
+
+template< class T, class R, class Op >
+gsl_api R parallel_reduce( thread_pool & pool, span<T> s, R init, Op op, in_order_t, size_t grain = 0 )
+{
+    detail::span_chunks<T> const chunks( s, grain );
+    dyn_array< detail::partial_result<R> > partials( chunks.count(), detail::partial_result<R>( init ) );
+
+    pool.run( chunks.count(), [&]( size_t i, size_t )
+    {
+        partials[i].value = detail::reduce_chunk<T, R>( chunks[i], op );
+    } );
+
+    for ( size_t i = 0; i < partials.size(); ++i )
+        init = op( init, partials[i].value );
+
+    return init;
+}
+
+template< class T, class R, class Op >
+gsl_api R parallel_reduce( span<T> s, R init, Op op, in_order_t, size_t grain = 0 )
+{
+    return parallel_reduce( default_thread_pool(), s, init, op, in_order, grain );
+}
+
+#endif // gsl_HAVE_THREAD
+
+#if gsl_HAVE_THREAD
+
+//
+// parallel_sort() - Sort a span on a thread_pool, by default on
+// default_thread_pool(). It does not allocate:
+//
+//     parallel_sort( span<record>( v ), by_key() );            // in place
+//     parallel_sort( span<record>( v ), span<record>( tmp ), by_key() );
+//
+// In place, the span is split into parts of equal size at its quantiles,
+// found with std::nth_element(), one level after the other, the parts of a
+// level in parallel. The parts are then sorted in parallel with std::sort().
+//
+// With a scratch span of at least the same size, runs of the span are sorted
+// in parallel with std::sort() and merged pairwise into the other span in
+// rounds. Each merge is divided into pieces of equal size along the merge path,
+// so that all participants merge in every round. This is the faster variant.
+//
+// Neither variant is stable.
+//
+namespace detail {
+
+const size_t parallel_sort_min_part = 8 * 1024;
+
+// the number of parts: a power of two of at least the concurrency, or fewer
+// to keep parts of at least parallel_sort_min_part elements:
+
+inline size_t sort_parts( size_t size, size_t concurrency ) gsl_noexcept
+{
+    size_t parts = 1;
+
+    while ( parts < concurrency && size / ( 2 * parts ) >= parallel_sort_min_part )
+        parts *= 2;
+
+    return parts;
+}
+
+// the first element of part k of n elements split into parts parts of equal size:
+
+struct part_bounds
+{
+    size_t n, parts;
+
+    size_t operator()( size_t k ) const gsl_noexcept
+    {
+        return n / parts * k + n % parts * k / parts;
+    }
+};
+
+// the number of elements of a that precede the element at position d of the
+// merge of a and b, as std::merge() takes equal elements from a first:
+
+template< class T, class Compare >
+size_t merge_path( T const * a, size_t na, T const * b, size_t nb, size_t d, Compare & cmp )
+{
+    size_t lo = d > nb ? d - nb : 0;
+    size_t hi = d < na ? d : na;
+
+    while ( lo < hi )
+    {
+        size_t const i = lo + ( hi - lo ) / 2;
+
+        if ( cmp( b[ d - i - 1 ], a[i] ) )
+            hi = i;
+        else
+            lo = i + 1;
+    }
+    return lo;
+}
+
+template< class T, class Compare >
+void parallel_sort_in_place( thread_pool & pool, span<T> s, Compare & cmp )
+{
+    T * const data = s.data();
+    size_t const n = s.size();
+    size_t const parts = sort_parts( n, pool.concurrency() );
+
+    part_bounds const at = { n, parts };
+
+    for ( size_t width = parts; width > 1; width /= 2 )
+    {
+        pool.run( parts / width, [&]( size_t segment, size_t )
+        {
+            size_t const first = segment * width;
+
+            std::nth_element( data + at( first ), data + at( first + width / 2 ), data + at( first + width ), cmp );
+        } );
+    }
+
+    pool.run( parts, [&]( size_t k, size_t )
+    {
+        std::sort( data + at( k ), data + at( k + 1 ), cmp );
+    } );
+}
+
+template< class T, class Compare >
+void parallel_sort_with_scratch( thread_pool & pool, span<T> s, span<T> scratch, Compare & cmp )
+{
+    size_t const n = s.size();
+    size_t const parts = sort_parts( n, pool.concurrency() );
+
+    part_bounds const at = { n, parts };
+
+    T * from = s.data();
+    T * to   = scratch.data();
+
+    pool.run( parts, [&]( size_t k, size_t )
+    {
+        std::sort( from + at( k ), from + at( k + 1 ), cmp );
+    } );
+
+    // merge pairs of runs of width parts, each pair in 2 * width pieces:
+
+    for ( size_t width = 1; width < parts; width *= 2 )
+    {
+        pool.run( parts, [&]( size_t k, size_t )
+        {
+            size_t const pair  = k / ( 2 * width );
+            size_t const piece = k % ( 2 * width );
+
+            size_t const begin  = at( pair * 2 * width );
+            size_t const middle = at( pair * 2 * width + width );
+            size_t const end    = at( pair * 2 * width + 2 * width );
+
+            T const * const a = from + begin;
+            T const * const b = from + middle;
+            size_t const na = middle - begin;
+            size_t const nb = end - middle;
+
+            part_bounds const pieces = { na + nb, 2 * width };
+
+            size_t const d0 = pieces( piece );
+            size_t const d1 = pieces( piece + 1 );
+
+            size_t const i0 = merge_path( a, na, b, nb, d0, cmp );
+            size_t const i1 = merge_path( a, na, b, nb, d1, cmp );
+
+            std::merge( a + i0, a + i1, b + ( d0 - i0 ), b + ( d1 - i1 ), to + begin + d0, cmp );
+        } );
+
+        std::swap( from, to );
+    }
+
+    if ( from != s.data() )
+    {
+        pool.run( parts, [&]( size_t k, size_t )
+        {
+            std::copy( from + at( k ), from + at( k + 1 ), s.data() + at( k ) );
+        } );
+    }
+}
+} // namespace detail
+
+template< class T, class Compare = std::less<T> >
+gsl_api void parallel_sort( thread_pool & pool, span<T> s, Compare cmp = Compare() )
+{
+    detail::parallel_sort_in_place( pool, s, cmp );
+}
+
+template< class T, class Compare = std::less<T> >
+gsl_api void parallel_sort( span<T> s, Compare cmp = Compare() )
+{
+    detail::parallel_sort_in_place( default_thread_pool(), s, cmp );
+}
+
+// scratch holds at least as many elements as s:
+
+template< class T, class Compare = std::less<T> >
+gsl_api void parallel_sort( thread_pool & pool, span<T> s, span<T> scratch, Compare cmp = Compare() )
+{
+    Expects( scratch.size() >= s.size() );
+
+    detail::parallel_sort_with_scratch( pool, s, scratch, cmp );
+}
+
+template< class T, class Compare = std::less<T> >
+gsl_api void parallel_sort( span<T> s, span<T> scratch, Compare cmp = Compare() )
+{
+    Expects( scratch.size() >= s.size() );
+
+    detail::parallel_sort_with_scratch( default_thread_pool(), s, scratch, cmp );
+}
+
+#endif // gsl_HAVE_THREAD
+
+//
+// radix_sort() - Sort a span of integer or floating point keys, or of structs
+// by a member key, with a least significant digit radix sort. The passes
+// distribute the elements by one byte of the key at a time, back and forth
+// between the span and a scratch span of at least the same size:
+//
+//     radix_sort( span<float>( samples ), span<float>( scratch ) );
+//     radix_sort( span<record>( records ), span<record>( scratch ), &record::key );
+//
+// Signed integers and IEEE floating point numbers are sorted in their numeric
+// order; -0.0 precedes +0.0, negative and positive NaNs go to the ends. The
+// sort is stable. A pass is skipped if all elements have the same value of
+// its byte, so that e.g. small keys take fewer passes.
+//
+namespace detail {
+
+template< size_t Size > struct unsigned_of_size;
+template<> struct unsigned_of_size<1> { typedef unsigned char      type; };
+template<> struct unsigned_of_size<2> { typedef unsigned short     type; };
+template<> struct unsigned_of_size<4> { typedef unsigned int       type; };
+template<> struct unsigned_of_size<8> { typedef unsigned long long type; };
+
+// a key as an unsigned integer in the same order as the keys:
+
+template< class K, bool Integer = std::numeric_limits<K>::is_integer, bool Signed = std::numeric_limits<K>::is_signed >
+struct radix_key
+{
+    typedef typename unsigned_of_size< sizeof( K ) >::type type;
+
+    static type bits( K k ) gsl_noexcept
+    {
+        return static_cast<type>( k );
+    }
+};
+
+// signed integer: flip the sign bit:
+
+template< class K >
+struct radix_key< K, true, true >
+{
+    typedef typename unsigned_of_size< sizeof( K ) >::type type;
+
+    static type bits( K k ) gsl_noexcept
+    {
+        return static_cast<type>( static_cast<type>( k ) ^ type( type( 1 ) << ( std::numeric_limits<type>::digits - 1 ) ) );
+    }
+};
+
+// floating point: flip the sign bit of a positive number, all bits of a negative one:
+
+template< class K >
+struct radix_key< K, false, true >
+{
+    typedef typename unsigned_of_size< sizeof( K ) >::type type;
+
+    static type bits( K k ) gsl_noexcept
+    {
+        gsl_STATIC_ASSERT( std::numeric_limits<K>::is_iec559, "radix_sort() requires IEEE floating point" );
+
+        type const sign = type( 1 ) << ( std::numeric_limits<type>::digits - 1 );
+        type u;
+        std::memcpy( &u, &k, sizeof( u ) );
+
+        return u & sign ? type( ~u ) : type( u | sign );
+    }
+};
+
+template< class T >
+struct radix_self
+{
+    typedef T key_type;
+
+    T const & operator()( T const & x ) const gsl_noexcept
+    {
+        return x;
+    }
+};
+
+template< class T, class K >
+struct radix_member
+{
+    typedef K key_type;
+
+    K T::* member;
+
+    K const & operator()( T const & x ) const gsl_noexcept
+    {
+        return x.*member;
+    }
+};
+
+template< class T, class Key >
+void radix_sort( span<T> s, span<T> scratch, Key key )
+{
+    typedef radix_key< typename remove_cv< typename Key::key_type >::type > traits;
+    typedef typename traits::type bits_type;
+
+    size_t const n = s.size();
+
+    if ( n < 2 )
+        return;
+
+    // the histograms of all bytes in one pass over the keys:
+
+    size_t counts[ sizeof( bits_type ) ][ 256 ] = { { 0 } };
+
+    for ( size_t i = 0; i < n; ++i )
+    {
+        bits_type const bits = traits::bits( key( s[i] ) );
+
+        for ( size_t d = 0; d < sizeof( bits_type ); ++d )
+            ++counts[d][ ( bits >> ( 8 * d ) ) & 0xff ];
+    }
+
+    T * from = s.data();
+    T * to   = scratch.data();
+
+    for ( size_t d = 0; d < sizeof( bits_type ); ++d )
+    {
+        size_t * const offsets = counts[d];
+
+        if ( offsets[ ( traits::bits( key( from[0] ) ) >> ( 8 * d ) ) & 0xff ] == n )
+            continue;
+
+        for ( size_t b = 0, sum = 0; b < 256; ++b )
+        {
+            size_t const count = offsets[b];
+            offsets[b] = sum;
+            sum += count;
+        }
+
+        for ( size_t i = 0; i < n; ++i )
+            to[ offsets[ ( traits::bits( key( from[i] ) ) >> ( 8 * d ) ) & 0xff ]++ ] = from[i];
+
+        std::swap( from, to );
+    }
+
+    if ( from != s.data() )
+        std::copy( from, from + n, s.data() );
+}
+} // namespace detail
+
+// scratch holds at least as many elements as s:
+
+template< class T >
+gsl_api void radix_sort( span<T> s, span<T> scratch )
+{
+    Expects( scratch.size() >= s.size() );
+
+    detail::radix_sort( s, scratch, detail::radix_self<T>() );
+}
+
+template< class T, class K >
+gsl_api void radix_sort( span<T> s, span<T> scratch, K T::* key )
+{
+    Expects( scratch.size() >= s.size() );
+
+    detail::radix_member<T, K> const by_member = { key };
+    detail::radix_sort( s, scratch, by_member );
+}
+#if gsl_HAVE_VARIADIC_TEMPLATES
+
+//
+// md_span<> - A view of a multidimensional array (C++11).
+//
+// Each extent is fixed at compile time or dynamic (dynamic_extent). The layout
+// maps indices to an offset: layout_right (row-major), layout_left (column-major)
+// or layout_stride (a stride per dimension):
+//
+//     md_span< float, extents<dynamic_extent, 3> > points( data, n );
+//     md_span< float, dextents<2>, layout_left > matrix( data, rows, cols );
+//
+//     points( i, 1 ) = matrix( r, c );
+//
+
+template< size_t... Extents >
+class extents;
+
+namespace detail {
+
+// static extent of dimension R:
+
+template< size_t R, size_t... E >
+struct static_extent_of;
+
+template< size_t R >
+struct static_extent_of< R >
+{
+    static const size_t value = 0;
+};
+
+template< size_t R, size_t E0, size_t... E >
+struct static_extent_of< R, E0, E... >
+{
+    static const size_t value = R == 0 ? E0 : static_extent_of< R == 0 ? 0 : R - 1, E... >::value;
+};
+
+// number of dynamic extents before dimension R:
+
+template< size_t R, size_t... E >
+struct dynamic_index_of;
+
+template< size_t R >
+struct dynamic_index_of< R >
+{
+    static const size_t value = 0;
+};
+
+template< size_t R, size_t E0, size_t... E >
+struct dynamic_index_of< R, E0, E... >
+{
+    static const size_t value = R == 0 ? 0 : ( E0 == dynamic_extent ) + dynamic_index_of< R == 0 ? 0 : R - 1, E... >::value;
+};
+
+// extents<> of R dynamic extents:
+
+template< size_t R, size_t... E >
+struct make_dextents
+{
+    typedef typename make_dextents< R - 1, dynamic_extent, E... >::type type;
+};
+
+template< size_t... E >
+struct make_dextents< 0, E... >
+{
+    typedef extents< E... > type;
+};
+
+// storage of N dynamic extents; empty if all extents are static:
+
+template< size_t N >
+struct dynamic_extents_storage
+{
+    gsl_api gsl_constexpr14 dynamic_extents_storage() gsl_noexcept
+        : values() {}
+
+    gsl_api gsl_constexpr14 dynamic_extents_storage( std::array< size_t, N > const & v ) gsl_noexcept
+        : values( v ) {}
+
+    gsl_api gsl_constexpr14 size_t get( size_t i ) const gsl_noexcept
+    {
+        return values[i];
+    }
+
+    std::array< size_t, N > values;
+};
+
+template<>
+struct dynamic_extents_storage< 0 >
+{
+    gsl_api gsl_constexpr14 dynamic_extents_storage() gsl_noexcept {}
+
+    gsl_api gsl_constexpr14 dynamic_extents_storage( std::array< size_t, 0 > const & ) gsl_noexcept {}
+
+    gsl_api gsl_constexpr14 size_t get( size_t ) const gsl_noexcept
+    {
+        return 0;
+    }
+};
+
+// bounds check, one index per dimension:
+
+template< size_t R, class Ext >
+gsl_api gsl_constexpr14 bool in_extents( Ext const & ) gsl_noexcept
+{
+    return true;
+}
+
+template< size_t R, class Ext, class I0, class... I >
+gsl_api gsl_constexpr14 bool in_extents( Ext const & e, I0 i0, I... i ) gsl_noexcept
+{
+    return static_cast<size_t>( i0 ) < e.template extent< R >() && in_extents< R + 1 >( e, i... );
+}
+
+// row-major offset, Horner scheme: ( ( i0 * e1 + i1 ) * e2 + i2 ) ...
+
+template< size_t R, class Ext >
+gsl_api gsl_constexpr14 size_t offset_right( Ext const &, size_t offset ) gsl_noexcept
+{
+    return offset;
+}
+
+template< size_t R, class Ext, class I0, class... I >
+gsl_api gsl_constexpr14 size_t offset_right( Ext const & e, size_t offset, I0 i0, I... i ) gsl_noexcept
+{
+    return offset_right< R + 1 >( e, offset * e.template extent< R >() + static_cast<size_t>( i0 ), i... );
+}
+
+// column-major offset: i0 + e0 * ( i1 + e1 * ( i2 ... ) )
+
+template< size_t R, class Ext, class I0 >
+gsl_api gsl_constexpr14 size_t offset_left( Ext const &, I0 i0 ) gsl_noexcept
+{
+    return static_cast<size_t>( i0 );
+}
+
+template< size_t R, class Ext, class I0, class I1, class... I >
+gsl_api gsl_constexpr14 size_t offset_left( Ext const & e, I0 i0, I1 i1, I... i ) gsl_noexcept
+{
+    return static_cast<size_t>( i0 ) + e.template extent< R >() * offset_left< R + 1 >( e, i1, i... );
+}
+
+// strided offset: i0 * s0 + i1 * s1 ...
+
+gsl_api gsl_constexpr14 inline size_t offset_strided( size_t const * ) gsl_noexcept
+{
+    return 0;
+}
+
+template< class I0, class... I >
+gsl_api gsl_constexpr14 size_t offset_strided( size_t const * strides, I0 i0, I... i ) gsl_noexcept
+{
+    return static_cast<size_t>( i0 ) * strides[0] + offset_strided( strides + 1, i... );
+}
+} // namespace detail
+
+//
+// extents<> - The extents of the dimensions of an md_span; only the
+// dynamic extents are stored.
+//
+template< size_t... Extents >
+class extents : private detail::dynamic_extents_storage< detail::dynamic_index_of< sizeof...( Extents ), Extents... >::value >
+{
+    typedef detail::dynamic_extents_storage< detail::dynamic_index_of< sizeof...( Extents ), Extents... >::value > storage;
+
+public:
+    typedef size_t index_type;
+
+    static_assert( sizeof...( Extents ) > 0, "extents<> requires at least one dimension" );
+
+    static gsl_constexpr size_t rank() gsl_noexcept
+    {
+        return sizeof...( Extents );
+    }
+
+    static gsl_constexpr size_t rank_dynamic() gsl_noexcept
+    {
+        return detail::dynamic_index_of< sizeof...( Extents ), Extents... >::value;
+    }
+
+    static gsl_constexpr14 index_type static_extent( size_t r ) gsl_noexcept
+    {
+        return std::array< index_type, sizeof...( Extents ) >{{ Extents... }}[ r ];
+    }
+
+    gsl_api gsl_constexpr14 extents() gsl_noexcept
+        : storage()
+    {}
+
+    template< class... I >
+    gsl_api gsl_constexpr14 explicit extents( I... dynamic_extents ) gsl_noexcept
+        : storage( std::array< index_type, sizeof...( I ) >{{ static_cast<index_type>( dynamic_extents )... }} )
+    {
+        static_assert( sizeof...( I ) == detail::dynamic_index_of< sizeof...( Extents ), Extents... >::value,
+            "extents<>: specify one value per dynamic extent" );
+    }
+
+    gsl_api gsl_constexpr14 explicit extents( std::array< index_type, detail::dynamic_index_of< sizeof...( Extents ), Extents... >::value > const & dynamic_extents ) gsl_noexcept
+        : storage( dynamic_extents )
+    {}
+
+    // extent of dimension R, a constant if it is static:
+
+    template< size_t R >
+    gsl_api gsl_constexpr14 index_type extent() const gsl_noexcept
+    {
+        return detail::static_extent_of< R, Extents... >::value != dynamic_extent
+            ? detail::static_extent_of< R, Extents... >::value
+            : storage::get( detail::dynamic_index_of< R, Extents... >::value );
+    }
+
+    gsl_api gsl_constexpr14 index_type extent( size_t r ) const gsl_noexcept
+    {
+        size_t k = 0;
+        for ( size_t i = 0; i < r; ++i )
+            k += static_extent( i ) == dynamic_extent;
+
+        return static_extent( r ) != dynamic_extent ? static_extent( r ) : storage::get( k );
+    }
+
+    // number of elements:
+
+    gsl_api gsl_constexpr14 index_type size() const gsl_noexcept
+    {
+        index_type n = 1;
+        for ( size_t r = 0; r < rank(); ++r )
+            n *= extent( r );
+        return n;
+    }
+
+    gsl_api gsl_constexpr14 friend bool operator==( extents const & l, extents const & r ) gsl_noexcept
+    {
+        for ( size_t i = 0; i < rank_dynamic(); ++i )
+        {
+            if ( l.get( i ) != r.get( i ) )
+                return false;
+        }
+        return true;
+    }
+
+    gsl_api gsl_constexpr14 friend bool operator!=( extents const & l, extents const & r ) gsl_noexcept
+    {
+        return !( l == r );
+    }
+};
+
+// extents<> of R dynamic extents:
 
-template< typename T >
-gsl_api gsl_constexpr14 span<T> as_span( T * begin, T * end )
-{
-    return span<T>( begin, end );
-}
+template< size_t R >
+using dextents = typename detail::make_dextents< R >::type;
 
-template< typename T >
-gsl_api gsl_constexpr14 span<T> as_span( T * begin, size_t size )
+//
+// layout_right - row-major (C) layout: the last index varies fastest.
+//
+struct layout_right
 {
-    return span<T>( begin, size );
-}
+    template< class Extents >
+    class mapping : private Extents
+    {
+    public:
+        typedef Extents extents_type;
+        typedef typename Extents::index_type index_type;
 
-template< typename T, size_t N >
-gsl_api gsl_constexpr14 span<T> as_span( T (&arr)[N] )
-{
-    return span<T>( arr, N );
-}
+        gsl_api gsl_constexpr14 mapping() gsl_noexcept
+            : Extents()
+        {}
 
-#if gsl_HAVE_ARRAY
+        gsl_api gsl_constexpr14 mapping( extents_type const & e ) gsl_noexcept
+            : Extents( e )
+        {}
 
-template< typename T, size_t N >
-gsl_api gsl_constexpr14 span<T> as_span( std::array<T,N> & arr )
-{
-    return span<T>( arr );
-}
+        gsl_api gsl_constexpr14 extents_type const & extents() const gsl_noexcept
+        {
+            return *this;
+        }
 
-template< typename T, size_t N >
-gsl_api gsl_constexpr14 span<const T> as_span( std::array<T,N> const & arr )
-{
-    return span<const T>( arr );
-}
-#endif
+        template< class I0, class... I >
+        gsl_api gsl_constexpr14 index_type operator()( I0 i0, I... i ) const gsl_noexcept
+        {
+            return detail::offset_right< 1 >( extents(), static_cast<index_type>( i0 ), i... );
+        }
 
-#if gsl_HAVE_CONSTRAINED_SPAN_CONTAINER_CTOR && gsl_HAVE_AUTO
+        gsl_api gsl_constexpr14 index_type required_span_size() const gsl_noexcept
+        {
+            return extents().size();
+        }
 
-template< class Cont >
-gsl_api gsl_constexpr14 auto as_span( Cont & cont ) -> span< typename Cont::value_type >
-{
-    return span< typename Cont::value_type >( cont );
-}
+        gsl_api gsl_constexpr14 index_type stride( size_t r ) const gsl_noexcept
+        {
+            index_type s = 1;
+            for ( size_t k = r + 1; k < extents_type::rank(); ++k )
+                s *= extents().extent( k );
+            return s;
+        }
 
-template< class Cont >
-gsl_api gsl_constexpr14 auto as_span( Cont const & cont ) -> span< const typename Cont::value_type >
+        gsl_api gsl_constexpr14 bool is_contiguous() const gsl_noexcept
+        {
+            return true;
+        }
+    };
+};
+
+//
+// layout_left - column-major (Fortran) layout: the first index varies fastest.
+//
+struct layout_left
 {
-    return span< const typename Cont::value_type >( cont );
-}
+    template< class Extents >
+    class mapping : private Extents
+    {
+    public:
+        typedef Extents extents_type;
+        typedef typename Extents::index_type index_type;
 
-#else
+        gsl_api gsl_constexpr14 mapping() gsl_noexcept
+            : Extents()
+        {}
 
-template< class T >
-gsl_api span<T> as_span( std::vector<T> & cont )
+        gsl_api gsl_constexpr14 mapping( extents_type const & e ) gsl_noexcept
+            : Extents( e )
+        {}
+
+        gsl_api gsl_constexpr14 extents_type const & extents() const gsl_noexcept
+        {
+            return *this;
+        }
+
+        template< class... I >
+        gsl_api gsl_constexpr14 index_type operator()( I... i ) const gsl_noexcept
+        {
+            return detail::offset_left< 0 >( extents(), i... );
+        }
+
+        gsl_api gsl_constexpr14 index_type required_span_size() const gsl_noexcept
+        {
+            return extents().size();
+        }
+
+        gsl_api gsl_constexpr14 index_type stride( size_t r ) const gsl_noexcept
+        {
+            index_type s = 1;
+            for ( size_t k = 0; k < r; ++k )
+                s *= extents().extent( k );
+            return s;
+        }
+
+        gsl_api gsl_constexpr14 bool is_contiguous() const gsl_noexcept
+        {
+            return true;
+        }
+    };
+};
+
+//
+// layout_stride - layout with a given stride in elements per dimension,
+// e.g. for a tile of an image or a column of a matrix.
+//
+struct layout_stride
 {
-    return span<T>( with_container, cont );
-}
+    template< class Extents >
+    class mapping
+    {
+    public:
+        typedef Extents extents_type;
+        typedef typename Extents::index_type index_type;
+        typedef std::array< index_type, Extents::rank() > strides_type;
+
+        gsl_api gsl_constexpr14 mapping() gsl_noexcept
+            : extents_()
+            , strides_()
+        {}
+
+        gsl_api gsl_constexpr14 mapping( extents_type const & e, strides_type const & s ) gsl_noexcept
+            : extents_( e )
+            , strides_( s )
+        {}
+
+        // row-major strides:
+
+        gsl_api gsl_constexpr14 mapping( extents_type const & e ) gsl_noexcept
+            : extents_( e )
+            , strides_()
+        {
+            layout_right::mapping< Extents > const right( e );
 
-template< class T >
-gsl_api span<const T> as_span( std::vector<T> const & cont )
+            for ( size_t r = 0; r < extents_type::rank(); ++r )
+                strides_[r] = right.stride( r );
+        }
+
+        // from a mapping of another layout:
+
+        template< class Mapping >
+        gsl_api gsl_constexpr14 mapping( Mapping const & other ) gsl_noexcept
+            : extents_( other.extents() )
+            , strides_()
+        {
+            for ( size_t r = 0; r < extents_type::rank(); ++r )
+                strides_[r] = other.stride( r );
+        }
+
+        gsl_api gsl_constexpr14 extents_type const & extents() const gsl_noexcept
+        {
+            return extents_;
+        }
+
+        gsl_api gsl_constexpr14 strides_type const & strides() const gsl_noexcept
+        {
+            return strides_;
+        }
+
+        template< class... I >
+        gsl_api gsl_constexpr14 index_type operator()( I... i ) const gsl_noexcept
+        {
+            return detail::offset_strided( strides_.data(), i... );
+        }
+
+        gsl_api gsl_constexpr14 index_type required_span_size() const gsl_noexcept
+        {
+            index_type n = 1;
+            for ( size_t r = 0; r < extents_type::rank(); ++r )
+            {
+                if ( extents_.extent( r ) == 0 )
+                    return 0;
+                n += ( extents_.extent( r ) - 1 ) * strides_[r];
+            }
+            return n;
+        }
+
+        gsl_api gsl_constexpr14 index_type stride( size_t r ) const gsl_noexcept
+        {
+            return strides_[r];
+        }
+
+        gsl_api gsl_constexpr14 bool is_contiguous() const gsl_noexcept
+        {
+            return required_span_size() == extents_.size();
+        }
+
+    private:
+        extents_type extents_;
+        strides_type strides_;
+    };
+};
+
+//
+// md_span<> - A view of a multidimensional array.
+//
+template< class T, class Extents, class Layout = layout_right >
+class md_span : private Layout::template mapping< Extents >
 {
-    return span<const T>( with_container, cont );
-}
-#endif
+public:
+    typedef Extents extents_type;
+    typedef Layout  layout_type;
+    typedef typename Layout::template mapping< Extents > mapping_type;
+
+    typedef size_t index_type;
+
+    typedef T element_type;
+    typedef typename detail::remove_cv< T >::type value_type;
+
+    typedef T & reference;
+    typedef T * pointer;
+
+    // sub-view type, see subspan():
+
+    typedef md_span< T, dextents< Extents::rank() >, layout_stride > strided_type;
+
+    gsl_api gsl_constexpr14 md_span() gsl_noexcept
+        : mapping_type()
+        , data_( nullptr )
+    {}
+
+    gsl_api gsl_constexpr14 md_span( pointer data_in, mapping_type const & m ) gsl_noexcept
+        : mapping_type( m )
+        , data_( data_in )
+    {}
+
+    gsl_api gsl_constexpr14 md_span( pointer data_in, extents_type const & e ) gsl_noexcept
+        : mapping_type( e )
+        , data_( data_in )
+    {}
+
+    template< class... I >
+    gsl_api gsl_constexpr14 md_span( pointer data_in, I... dynamic_extents ) gsl_noexcept
+        : mapping_type( extents_type( dynamic_extents... ) )
+        , data_( data_in )
+    {}
+
+    // from a span that holds at least required_span_size() elements:
+
+    gsl_api gsl_constexpr14 md_span( span<T> s, mapping_type const & m )
+        : mapping_type( m )
+        , data_( s.data() )
+    {
+        Expects( mapping().required_span_size() <= s.size() );
+    }
+
+    template< class... I >
+    gsl_api gsl_constexpr14 md_span( span<T> s, I... dynamic_extents )
+        : mapping_type( extents_type( dynamic_extents... ) )
+        , data_( s.data() )
+    {
+        Expects( mapping().required_span_size() <= s.size() );
+    }
+
+    template< class U >
+    gsl_api gsl_constexpr14 md_span( md_span< U, Extents, Layout > const & other ) gsl_noexcept
+        : mapping_type( other.mapping() )
+        , data_( other.data() )
+    {}
+
+    // element access, one index per dimension:
+
+    template< class... I >
+    gsl_api gsl_constexpr14 reference operator()( I... indices ) const
+    {
+        static_assert( sizeof...( I ) == Extents::rank(), "md_span<>: specify one index per dimension" );
+
+        Expects( detail::in_extents< 0 >( mapping().extents(), indices... ) );
+        return data_[ mapping()( indices... ) ];
+    }
+
+    static gsl_constexpr size_t rank() gsl_noexcept
+    {
+        return Extents::rank();
+    }
+
+    static gsl_constexpr size_t rank_dynamic() gsl_noexcept
+    {
+        return Extents::rank_dynamic();
+    }
+
+    static gsl_constexpr14 index_type static_extent( size_t r ) gsl_noexcept
+    {
+        return Extents::static_extent( r );
+    }
+
+    gsl_api gsl_constexpr14 index_type extent( size_t r ) const gsl_noexcept
+    {
+        return mapping().extents().extent( r );
+    }
+
+    gsl_api gsl_constexpr14 extents_type const & extents() const gsl_noexcept
+    {
+        return mapping().extents();
+    }
+
+    gsl_api gsl_constexpr14 mapping_type const & mapping() const gsl_noexcept
+    {
+        return *this;
+    }
+
+    gsl_api gsl_constexpr14 index_type stride( size_t r ) const gsl_noexcept
+    {
+        return mapping().stride( r );
+    }
+
+    gsl_api gsl_constexpr14 bool is_contiguous() const gsl_noexcept
+    {
+        return mapping().is_contiguous();
+    }
+
+    gsl_api gsl_constexpr14 index_type size() const gsl_noexcept
+    {
+        return mapping().extents().size();
+    }
+
+    gsl_api gsl_constexpr14 bool empty() const gsl_noexcept
+    {
+        return size() == 0;
+    }
+
+    gsl_api gsl_constexpr14 pointer data() const gsl_noexcept
+    {
+        return data_;
+    }
+
+    // the elements spanned, including those skipped by a strided layout:
+
+    gsl_api gsl_constexpr14 span<T> as_span() const gsl_noexcept
+    {
+        return span<T>( data_, mapping().required_span_size() );
+    }
+
+    gsl_api span< const byte > as_bytes() const gsl_noexcept
+    {
+        return as_span().as_bytes();
+    }
+
+    gsl_api span< byte > as_writeable_bytes() const gsl_noexcept
+    {
+        return as_span().as_writeable_bytes();
+    }
+
+    // sub-view of sizes[r] elements from offsets[r] on in each dimension:
+
+    gsl_api gsl_constexpr14 strided_type subspan(
+        std::array< index_type, Extents::rank() > const & offsets,
+        std::array< index_type, Extents::rank() > const & sizes ) const
+    {
+        std::array< index_type, Extents::rank() > strides = {{}};
+        index_type offset = 0;
+
+        for ( size_t r = 0; r < rank(); ++r )
+        {
+            Expects( offsets[r] <= extent( r ) && sizes[r] <= extent( r ) - offsets[r] );
+
+            strides[r] = stride( r );
+            offset    += offsets[r] * strides[r];
+        }
+
+        return strided_type( data_ + offset,
+            typename strided_type::mapping_type( typename strided_type::extents_type( sizes ), strides ) );
+    }
+
+private:
+    pointer data_;
+};
+
+#endif // gsl_HAVE_VARIADIC_TEMPLATES
 
 //
 // String types:
@@ -1394,22 +7557,110 @@ gsl_api inline std::wstring to_string( cwstring_span const & view )
 //
 namespace detail {
 
-template<class T, class SizeType, const T Sentinel>
-gsl_api static span<T> ensure_sentinel( T * seq, SizeType max = std::numeric_limits<SizeType>::max() )
+// index of the first element equal to sentinel in seq[0..max), or max:
+
+template< class T >
+size_t find_sentinel( T const * seq, T sentinel, size_t max, false_type )
 {
-    typedef T * pointer;
+    size_t i = 0;
+    for ( ; i < max && !( seq[i] == sentinel ); ++i )
+    {}
+    return i;
+}
+
+#if gsl_HAVE_SSE2
+
+// Compare a SIMD vector of elements at a time. Only aligned blocks are read:
+// they never cross a page boundary, so no block is read that does not contain
+// at least one element up to and including the sentinel. Out of line, so that
+// compilers do not see the object and warn about the block beyond it.
+
+template< class T >
+gsl_NO_SANITIZE_ADDRESS gsl_NOINLINE
+size_t find_sentinel( T const * seq, T sentinel, size_t max, true_type )
+{
+    typedef simd_lanes< sizeof( T ) > lanes;
+
+    char const * const p = reinterpret_cast<char const *>( seq );
+    size_t const misalign = reinterpret_cast<size_t>( p ) % simd_width;
+    simd_vector const needle = lanes::splat( sentinel );
+
+    unsigned mask = simd_mask( lanes::equal( simd_load( p - misalign ), needle ) ) >> misalign;
 
-    pointer cur = seq;
+    if ( mask != 0 )
+        return (std::min)( count_trailing_zeros( mask ) / sizeof( T ), max );
 
-    while ( static_cast<SizeType>( cur - seq ) < max && *cur != Sentinel )
-        ++cur;
+    for ( size_t offset = simd_width - misalign; offset / sizeof( T ) < max; offset += simd_width )
+    {
+        mask = simd_mask( lanes::equal( simd_load( p + offset ), needle ) );
+
+        if ( mask != 0 )
+            return (std::min)( ( offset + count_trailing_zeros( mask ) ) / sizeof( T ), max );
+    }
+    return max;
+}
+
+#else // gsl_HAVE_SSE2
+
+// Compare a machine word at a time. Only aligned words are read, see above.
+
+template< class T >
+gsl_NO_SANITIZE_ADDRESS gsl_NOINLINE
+size_t find_sentinel( T const * seq, T sentinel, size_t max, true_type )
+{
+    typedef size_t word;
+
+    size_t i = 0;
+    for ( ; i < max && reinterpret_cast<size_t>( seq + i ) % sizeof( word ) != 0; ++i )
+    {
+        if ( seq[i] == sentinel )
+            return i;
+    }
+
+    // lanes of sizeof(T) bytes: lows has the lowest, highs the highest bit of each lane set:
+    word const lows  = ~word( 0 ) / ( ( word( 1 ) << ( 4 * sizeof( T ) ) << ( 4 * sizeof( T ) ) ) - 1 );
+    word const highs = lows << ( 8 * sizeof( T ) - 1 );
+    word const pattern = lows * to_bits< typename uint_of_size< sizeof( T ) >::type >( sentinel );
+
+    for ( ; i < max; i += sizeof( word ) / sizeof( T ) )
+    {
+        word x;
+        std::memcpy( &x, seq + i, sizeof( x ) );
+        x ^= pattern;
+
+        if ( ( ( x - lows ) & ~x & highs ) != 0 )
+            break;
+    }
+    for ( ; i < max && !( seq[i] == sentinel ); ++i )
+    {}
+    return (std::min)( i, max );
+}
+
+#endif // gsl_HAVE_SSE2
+
+template< class T >
+gsl_api span<T> ensure_sentinel( T * seq, T sentinel, size_t max )
+{
+    size_t const length = find_sentinel<typename remove_cv<T>::type>( seq, sentinel, max, is_simd_searchable<T>() );
+
+    Expects( seq[ length ] == sentinel );
 
-    Expects( *cur == Sentinel );
+    return span<T>( seq, length );
+}
 
-    return span<T>( seq, cur - seq );
+template<class T, class SizeType, const T Sentinel>
+gsl_api static span<T> ensure_sentinel( T * seq, SizeType max = std::numeric_limits<SizeType>::max() )
+{
+    return detail::ensure_sentinel<T>( seq, Sentinel, static_cast<size_t>( max ) );
 }
 } // namespace detail
 
+template< class T >
+gsl_api inline span<T> ensure_sentinel( T * seq, typename detail::remove_cv<T>::type sentinel, size_t max = std::numeric_limits<size_t>::max() )
+{
+    return detail::ensure_sentinel<T>( seq, sentinel, max );
+}
+
 //
 // ensure_z - creates a string_span for a czstring or cwzstring.
 // Will fail fast if a null-terminator cannot be found before
@@ -1419,7 +7670,7 @@ gsl_api static span<T> ensure_sentinel( T * seq, SizeType max = std::numeric_lim
 template< class T >
 gsl_api inline span<T> ensure_z( T * const & sz, size_t max = std::numeric_limits<size_t>::max() )
 {
-    return detail::ensure_sentinel<T, size_t, 0>( sz, max );
+    return ensure_sentinel( sz, 0, max );
 }
 
 template< class T, size_t N >
@@ -0,0 +1,221 @@
+//
+// gsl-lite is based on GSL: Guideline Support Library,
+// https://github.com/microsoft/gsl
+//
+// Copyright (c) 2015 Martin Moene
+// Copyright (c) 2015 Microsoft Corporation. All rights reserved.
+//
+// This code is licensed under the MIT License (MIT).
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "gsl-lite.t.h"
+
+namespace {
+
+// records the order of destruction, throws on the construction of instance number throw_at:
+
+struct logged
+{
+    static int log[8];
+    static int destroyed;
+    static int throw_at;
+    static int constructed;
+
+    int id;
+
+    logged( int id_ = 0 )
+        : id( id_ )
+    {
+        if ( ++constructed == throw_at )
+            throw std::runtime_error( "logged" );
+    }
+
+    ~logged()
+    {
+        if ( destroyed < 8 )
+            log[ destroyed ] = id;
+        ++destroyed;
+    }
+
+    static void clear()
+    {
+        destroyed = constructed = throw_at = 0;
+    }
+};
+
+int logged::log[8]     = { 0 };
+int logged::destroyed   = 0;
+int logged::throw_at    = 0;
+int logged::constructed = 0;
+
+struct point
+{
+    point( int x_, int y_ ) : x( x_ ), y( y_ ) {}
+    int x, y;
+};
+
+bool is_aligned( void const * p, size_t alignment )
+{
+    return reinterpret_cast<size_t>( p ) % alignment == 0;
+}
+
+bool is_within( void const * p, span<byte> s )
+{
+    size_t const a = reinterpret_cast<size_t>( p );
+    size_t const b = reinterpret_cast<size_t>( s.data() );
+    return a >= b && a < b + s.size();
+}
+}
+
+CASE( "arena: Allows to allocate a span of value-initialized elements" )
+{
+    arena a;
+
+    span<int> s = a.allocate<int>( 5 );
+
+    EXPECT( s.size() == 5u );
+    EXPECT( s[0] == 0 );
+    EXPECT( s[4] == 0 );
+    EXPECT( is_aligned( s.data(), sizeof( int ) ) );
+}
+
+CASE( "arena: Allows to allocate a span of default-initialized elements" )
+{
+    arena a;
+
+    span<double> s = a.allocate<double>( 1000, with_default_init );
+
+    EXPECT( s.size() == 1000u );
+    EXPECT( is_aligned( s.data(), sizeof( double ) ) );
+}
+
+CASE( "arena: Allows to allocate bytes with a given alignment" )
+{
+    arena a;
+
+    a.allocate_bytes( 1 );
+
+    EXPECT( is_aligned( a.allocate_bytes( 10, 64 ), 64 ) );
+    EXPECT( is_aligned( a.allocate_bytes(  1, 4096 ), 4096 ) );
+}
+
+CASE( "arena: Allows to create an object" )
+{
+    arena a;
+
+    Owner(point *) p = a.create<point>( 1, 2 );
+
+    EXPECT( p->x == 1 );
+    EXPECT( p->y == 2 );
+}
+
+CASE( "arena: Allows to chain blocks when a block is full" )
+{
+    arena a( 64 );
+
+    span<int> s = a.allocate<int>( 10 );
+    span<int> t = a.allocate<int>( 10 );
+    span<int> u = a.allocate<int>( 1000 );
+
+    s[9] = 1; t[9] = 2; u[999] = 3;
+
+    EXPECT( s[9] + t[9] + u[999] == 6 );
+    EXPECT( t.data() != s.data() + 10 );
+}
+
+CASE( "arena: Allows to start with a buffer of the caller" )
+{
+    byte buffer[64];
+    span<byte> b( buffer );
+
+    arena a( b );
+
+    int * p = a.allocate<int>( 4 ).data();
+    int * q = a.allocate<int>( 100 ).data();
+
+    EXPECT(  is_within( p, b ) );
+    EXPECT( !is_within( q, b ) );
+
+    a.reset();
+
+    EXPECT( a.allocate<int>( 4 ).data() == p );
+}
+
+CASE( "arena: Allows to reuse its blocks after reset()" )
+{
+    arena a( 64 );
+
+    int * p = a.allocate<int>( 10 ).data();
+    int * q = a.allocate<int>( 10 ).data();
+
+    a.reset();
+
+    EXPECT( a.allocate<int>( 10 ).data() == p );
+    EXPECT( a.allocate<int>( 10 ).data() == q );
+}
+
+CASE( "arena: Destroys objects in reverse order of creation on reset()" )
+{
+    logged::clear();
+
+    arena a;
+
+    a.create<logged>( 1 );
+    a.allocate<logged>( 2 );
+    a.create<logged>( 3 );
+
+    EXPECT( logged::destroyed == 0 );
+
+    a.reset();
+
+    EXPECT( logged::destroyed == 4 );
+    EXPECT( logged::log[0] == 3 );
+    EXPECT( logged::log[3] == 1 );
+
+    a.reset();
+
+    EXPECT( logged::destroyed == 4 );
+}
+
+CASE( "arena: Destroys objects on destruction" )
+{
+    logged::clear();
+    {
+        arena a;
+        a.create<logged>( 1 );
+    }
+    EXPECT( logged::destroyed == 1 );
+}
+
+CASE( "arena: Destroys the constructed elements if construction of an element throws" )
+{
+    logged::clear();
+    logged::throw_at = 3;
+
+    arena a;
+
+    EXPECT_THROWS( a.allocate<logged>( 5 ) );
+    EXPECT( logged::destroyed == 2 );
+
+    a.reset();
+
+    EXPECT( logged::destroyed == 2 );
+
+    logged::clear();
+}
+
+CASE( "arena: Terminates on an alignment that is not a power of two" )
+{
+    arena a;
+
+    EXPECT_THROWS( a.allocate_bytes( 8, 3 ) );
+}
+
+// end of file
@@ -17,11 +17,50 @@
 
 #include "gsl-lite.t.h"
 
+#if gsl_CONFIG_CONTRACT_COUNTERS
+# include <thread>
+#endif
+
 namespace {
 
 bool expects( bool x ) { Expects( x ); return x; } 
 bool ensures( bool x ) { Ensures( x ); return x; }
-    
+
+#if gsl_CONFIG_CONTRACT_COUNTERS
+
+bool counted( int x ) { Expects( x != 42 ); return true; }
+
+bool counted_pointer( int const * p ) { Expects( p != NULL ); return true; }
+
+contract_counter counter_of( char const * condition )
+{
+    std::vector<contract_counter> counters = contract_counters();
+
+    for ( size_t i = 0; i < counters.size(); ++i )
+    {
+        if ( std::string( counters[i].condition ) == condition )
+            return counters[i];
+    }
+    contract_counter none = { "", "", "", 0, 0, 0 };
+    return none;
+}
+
+void count_many()
+{
+    for ( int i = 0; i < 1000; ++i )
+        counted( 100 + i );
+}
+
+void count_once()
+{
+    counted( 1 );
+}
+
+size_t registered_sites()
+{
+    return gsl::detail::contract_sites().sites.size();
+}
+#endif
 }
 
 CASE( "Expects(): Allows a true expression" )
@@ -44,4 +83,76 @@ CASE( "Ensures(): Terminates on a false expression" )
     EXPECT_THROWS( ensures( false ) );
 }
 
+CASE( "contract_counters(): Allows to obtain evaluations and failures per contract site" )
+{
+#if gsl_CONFIG_CONTRACT_COUNTERS
+    reset_contract_counters();
+
+    counted( 1 );
+    counted( 2 );
+    EXPECT_THROWS( counted( 42 ) );
+
+    contract_counter const counter = counter_of( "x != 42" );
+
+    EXPECT( counter.evaluations == 3u );
+    EXPECT( counter.failures    == 1u );
+    EXPECT( std::string( counter.kind ) == "Expects" );
+    EXPECT( counter.line > 0 );
+#else
+    EXPECT( !!"contract counters are not enabled (gsl_CONFIG_CONTRACT_COUNTERS)" );
+#endif
+}
+
+CASE( "contract_counters(): Shows the condition as written, before macro expansion" )
+{
+#if gsl_CONFIG_CONTRACT_COUNTERS
+    reset_contract_counters();
+
+    int x = 0;
+    counted_pointer( &x );
+
+    EXPECT( counter_of( "p != NULL" ).evaluations == 1u );
+#else
+    EXPECT( !!"contract counters are not enabled (gsl_CONFIG_CONTRACT_COUNTERS)" );
+#endif
+}
+
+CASE( "contract_counters(): Sums the counts of all threads" )
+{
+#if gsl_CONFIG_CONTRACT_COUNTERS
+    reset_contract_counters();
+
+    std::thread a( count_many ), b( count_many );
+    count_many();
+    a.join();
+    b.join();
+
+    EXPECT( counter_of( "x != 42" ).evaluations == 3000u );
+    EXPECT( counter_of( "x != 42" ).failures    ==    0u );
+#else
+    EXPECT( !!"contract counters are not enabled (gsl_CONFIG_CONTRACT_COUNTERS)" );
+#endif
+}
+
+CASE( "contract_counters(): Registers a site once, however many threads evaluate it" )
+{
+#if gsl_CONFIG_CONTRACT_COUNTERS
+    reset_contract_counters();
+
+    count_once();
+    size_t const sites = registered_sites();
+
+    for ( int i = 0; i < 100; ++i )
+    {
+        std::thread t( count_once );
+        t.join();
+    }
+
+    EXPECT( registered_sites() == sites );
+    EXPECT( counter_of( "x != 42" ).evaluations == 101u );
+#else
+    EXPECT( !!"contract counters are not enabled (gsl_CONFIG_CONTRACT_COUNTERS)" );
+#endif
+}
+
 // end of file
@@ -0,0 +1,222 @@
+//
+// gsl-lite is based on GSL: Guideline Support Library,
+// https://github.com/microsoft/gsl
+//
+// Copyright (c) 2015 Martin Moene
+// Copyright (c) 2015 Microsoft Corporation. All rights reserved.
+//
+// This code is licensed under the MIT License (MIT).
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "gsl-lite.t.h"
+
+#if gsl_HAVE_THREAD
+
+#include <sstream>
+
+namespace {
+
+// reads from text, at most max_read bytes at a time, throws at offset fail_at:
+
+struct text_source
+{
+    text_source( std::string const & text_, size_t max_read_ = size_t( -1 ), size_t fail_at_ = size_t( -1 ) )
+        : text( text_ ), pos( 0 ), max_read( max_read_ ), fail_at( fail_at_ ) {}
+
+    size_t operator()( span<byte> buffer )
+    {
+        if ( pos >= fail_at )
+            throw std::runtime_error( "text_source" );
+
+        size_t const n = std::min( std::min( buffer.size(), max_read ), text.size() - pos );
+        std::memcpy( buffer.data(), text.data() + pos, n );
+        pos += n;
+        return n;
+    }
+
+    std::string text;
+    size_t pos;
+    size_t max_read;
+    size_t fail_at;
+};
+
+std::string numbered_lines( int n )
+{
+    std::ostringstream os;
+    for ( int i = 0; i < n; ++i )
+        os << "record " << i << std::string( size_t( i % 13 ), '.' ) << "\n";
+    return os.str();
+}
+
+std::string as_string( span<const byte> s )
+{
+    return std::string( reinterpret_cast<char const *>( s.data() ), s.size() );
+}
+
+// read all chunks, keeping nothing:
+
+std::string read_all( chunk_reader & reader, size_t & chunks )
+{
+    std::string result;
+    chunks = 0;
+    for ( span<const byte> chunk; !( chunk = reader.next() ).empty(); ++chunks )
+        result += as_string( chunk );
+    return result;
+}
+
+// count complete lines in chunk, return the size of an incomplete last line:
+
+size_t parse_lines( span<const byte> chunk, std::vector<std::string> & lines )
+{
+    std::string const text = as_string( chunk );
+    size_t begin = 0;
+
+    for ( size_t end; ( end = text.find( '\n', begin ) ) != std::string::npos; begin = end + 1 )
+        lines.push_back( text.substr( begin, end - begin ) );
+
+    return text.size() - begin;
+}
+}
+#endif
+
+CASE( "chunk_reader: Allows to read a stream in chunks" )
+{
+#if gsl_HAVE_THREAD
+    std::string const text = numbered_lines( 1000 );
+
+    chunk_reader reader( text_source( text ), 1000, 100 );
+
+    size_t chunks = 0;
+
+    EXPECT( read_all( reader, chunks ) == text );
+    EXPECT( chunks == ( text.size() + 999 ) / 1000 );
+    EXPECT( reader.next().empty() );
+#else
+    EXPECT( !!"chunk_reader is not available (no C++11)" );
+#endif
+}
+
+CASE( "chunk_reader: Allows a source that reads less than requested" )
+{
+#if gsl_HAVE_THREAD
+    std::string const text = numbered_lines( 100 );
+
+    chunk_reader reader( text_source( text, 7 ), 256, 64 );
+
+    EXPECT( reader.next().size() == 256u );
+#else
+    EXPECT( !!"chunk_reader is not available (no C++11)" );
+#endif
+}
+
+CASE( "chunk_reader: Allows to keep an incomplete record for the next chunk" )
+{
+#if gsl_HAVE_THREAD
+    std::string const text = numbered_lines( 1000 );
+    std::vector<std::string> lines;
+
+    chunk_reader reader( text_source( text ), 333, 64, 3 );
+
+    size_t keep = 0;
+    for ( span<const byte> chunk; !( chunk = reader.next( keep ) ).empty(); )
+        keep = parse_lines( chunk, lines );
+
+    EXPECT( keep == 0u );
+    EXPECT( lines.size() == 1000u );
+    EXPECT( lines[0]   == "record 0" );
+    EXPECT( lines[999] == "record 999" + std::string( 999 % 13, '.' ) );
+#else
+    EXPECT( !!"chunk_reader is not available (no C++11)" );
+#endif
+}
+
+CASE( "chunk_reader: Provides chunks at the given alignment" )
+{
+#if gsl_HAVE_THREAD
+    std::string const text( 10000, 'x' );
+
+    chunk_reader reader( text_source( text ), 1000, 100, 4, 512 );
+
+    for ( span<const byte> chunk; !( chunk = reader.next() ).empty(); )
+        EXPECT( reinterpret_cast<size_t>( chunk.data() ) % 512 == 0u );
+#else
+    EXPECT( !!"chunk_reader is not available (no C++11)" );
+#endif
+}
+
+CASE( "chunk_reader: Allows to read from a pipe" )
+{
+#if gsl_HAVE_THREAD && gsl_HAVE_MMAP
+    std::string const text = numbered_lines( 5000 );
+
+    int fds[2];
+    EXPECT( ::pipe( fds ) == 0 );
+
+    std::thread writer( [&]
+    {
+        for ( size_t pos = 0; pos < text.size(); pos += 100 )
+            EXPECT( ::write( fds[1], text.data() + pos, std::min( size_t( 100 ), text.size() - pos ) ) > 0 );
+        ::close( fds[1] );
+    } );
+
+    std::string result;
+    {
+        chunk_reader reader( fds[0], 4096, 256 );
+        size_t chunks = 0;
+        result = read_all( reader, chunks );
+    }
+    writer.join();
+    ::close( fds[0] );
+
+    EXPECT( result == text );
+#else
+    EXPECT( !!"chunk_reader is not available (no C++11 or no POSIX)" );
+#endif
+}
+
+CASE( "chunk_reader: Rethrows an exception of the source" )
+{
+#if gsl_HAVE_THREAD
+    chunk_reader reader( text_source( std::string( 3000, 'x' ), 100, 1500 ), 1000, 100 );
+
+    EXPECT( reader.next().size() == 1000u );
+    EXPECT( reader.next().size() ==  500u );
+    EXPECT_THROWS_AS( reader.next(), std::runtime_error );
+#else
+    EXPECT( !!"chunk_reader is not available (no C++11)" );
+#endif
+}
+
+CASE( "chunk_reader: Terminates on keeping more than the current chunk or the maximum tail" )
+{
+#if gsl_HAVE_THREAD
+    chunk_reader reader( text_source( std::string( 3000, 'x' ) ), 1000, 100 );
+
+    EXPECT_THROWS( reader.next( 1 ) );
+
+    reader.next();
+
+    EXPECT_THROWS( reader.next( 101 ) );
+#else
+    EXPECT( !!"chunk_reader is not available (no C++11)" );
+#endif
+}
+
+CASE( "chunk_reader: Terminates on an alignment that is not a power of two" )
+{
+#if gsl_HAVE_THREAD
+    EXPECT_THROWS( chunk_reader( text_source( "x" ), 1000, 100, 2, 0 ) );
+    EXPECT_THROWS( chunk_reader( text_source( "x" ), 1000, 100, 2, 3 ) );
+#else
+    EXPECT( !!"chunk_reader is not available (no C++11)" );
+#endif
+}
+
+// end of file
@@ -0,0 +1,227 @@
+//
+// gsl-lite is based on GSL: Guideline Support Library,
+// https://github.com/microsoft/gsl
+//
+// Copyright (c) 2015 Martin Moene
+// Copyright (c) 2015 Microsoft Corporation. All rights reserved.
+//
+// This code is licensed under the MIT License (MIT).
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "gsl-lite.t.h"
+
+namespace {
+
+// counts live instances, throws on the construction of instance number throw_at:
+
+struct counted
+{
+    static int live;
+    static int throw_at;
+    static int constructed;
+
+    counted()
+    {
+        if ( ++constructed == throw_at )
+            throw std::runtime_error( "counted" );
+        ++live;
+    }
+
+    counted( counted const & )
+    {
+        ++live;
+    }
+
+    ~counted()
+    {
+        --live;
+    }
+};
+
+int counted::live        = 0;
+int counted::throw_at    = 0;
+int counted::constructed = 0;
+
+int sum( span<const int> s )
+{
+    int result = 0;
+    for ( size_t i = 0; i < s.size(); ++i )
+        result += s[i];
+    return result;
+}
+
+void fill( span<int> s, int value )
+{
+    for ( size_t i = 0; i < s.size(); ++i )
+        s[i] = value;
+}
+
+bool is_aligned( void const * p, size_t alignment )
+{
+    return reinterpret_cast<size_t>( p ) % alignment == 0;
+}
+}
+
+CASE( "dyn_array<>: Allows to default-construct an empty array" )
+{
+    dyn_array<int> a;
+
+    EXPECT( a.empty() );
+    EXPECT( a.size() == 0u );
+    EXPECT( a.begin() == a.end() );
+}
+
+CASE( "dyn_array<>: Allows to construct an array of value-initialized elements" )
+{
+    dyn_array<int> a( 5 );
+
+    EXPECT( a.size() == 5u );
+    EXPECT( a[0] == 0 );
+    EXPECT( a[4] == 0 );
+}
+
+CASE( "dyn_array<>: Allows to construct an array of default-initialized elements" )
+{
+    counted::live = 0;
+    {
+        dyn_array<counted> a( 3, with_default_init );
+        dyn_array<int> b( 1000, with_default_init );
+
+        EXPECT( counted::live == 3 );
+        EXPECT( b.size() == 1000u );
+    }
+    EXPECT( counted::live == 0 );
+}
+
+CASE( "dyn_array<>: Allows to construct an array filled with a value" )
+{
+    dyn_array<int> a( 3, 7 );
+
+    EXPECT( a[0] == 7 );
+    EXPECT( a[2] == 7 );
+}
+
+CASE( "dyn_array<>: Allows to construct an array as a copy of a span" )
+{
+    int arr[] = { 1, 2, 3, };
+
+    dyn_array<int> a( as_span( arr ) );
+
+    EXPECT( a.size() == 3u );
+    EXPECT( a[2] == 3 );
+}
+
+CASE( "dyn_array<>: Allows to specify the alignment of the elements" )
+{
+    dyn_array<char, 64>   a( 3 );
+    dyn_array<char, 4096> b( 3 );
+    dyn_array<double, 32> c( 100, 1.5 );
+
+    EXPECT( is_aligned( a.data(),   64 ) );
+    EXPECT( is_aligned( b.data(), 4096 ) );
+    EXPECT( is_aligned( c.data(),   32 ) );
+    EXPECT( c.alignment() == 32u );
+    EXPECT( c[99] == 1.5 );
+}
+
+CASE( "dyn_array<>: Allows to convert implicitly to a span" )
+{
+#if gsl_HAVE_CONSTRAINED_SPAN_CONTAINER_CTOR || gsl_HAVE_UNCONSTRAINED_SPAN_CONTAINER_CTOR
+    dyn_array<int> a( 4 );
+
+    fill( a, 3 );
+
+    dyn_array<int> const & c = a;
+
+    EXPECT( sum( c ) == 12 );
+#else
+    EXPECT( !!"(un)constrained construction from container is not available" );
+#endif
+}
+
+CASE( "dyn_array<>: Allows to create a span with as_span()" )
+{
+    dyn_array<int> a( 4 );
+    dyn_array<int> const & c = a;
+
+    fill( as_span( a ), 2 );
+
+    EXPECT( sum( as_span( c ) ) == 8 );
+    EXPECT( as_span( c ).data() == a.data() );
+}
+
+CASE( "dyn_array<>: Allows to copy-construct and copy-assign" )
+{
+    dyn_array<int> a( 3, 1 );
+    dyn_array<int> b( a );
+    dyn_array<int> c;
+
+    c = a;
+    b[0] = 2;
+
+    EXPECT( a[0] == 1 );
+    EXPECT( b[0] == 2 );
+    EXPECT( c.size() == 3u );
+    EXPECT( c.data() != a.data() );
+}
+
+CASE( "dyn_array<>: Allows to move-construct and move-assign (C++11)" )
+{
+#if gsl_CPP11_OR_GREATER
+    dyn_array<int> a( 3, 1 );
+    int * const p = a.data();
+
+    dyn_array<int> b( std::move( a ) );
+
+    EXPECT( b.data() == p );
+    EXPECT( a.empty() );
+
+    dyn_array<int> c;
+    c = std::move( b );
+
+    EXPECT( c.data() == p );
+    EXPECT( b.empty() );
+#else
+    EXPECT( !!"move-semantics are not available (no C++11)" );
+#endif
+}
+
+CASE( "dyn_array<>: Allows to swap with another dyn_array" )
+{
+    dyn_array<int> a( 3 );
+    dyn_array<int> b( 5 );
+
+    a.swap( b );
+
+    EXPECT( a.size() == 5u );
+    EXPECT( b.size() == 3u );
+}
+
+CASE( "dyn_array<>: Destroys the constructed elements if construction of an element throws" )
+{
+    counted::live        = 0;
+    counted::constructed = 0;
+    counted::throw_at    = 3;
+
+    EXPECT_THROWS( dyn_array<counted>( 5 ) );
+    EXPECT( counted::live == 0 );
+
+    counted::throw_at = 0;
+}
+
+CASE( "dyn_array<>: Terminates on access outside the array" )
+{
+    dyn_array<int> a( 3 );
+
+    EXPECT_THROWS( a[3] );
+    EXPECT_THROWS( a.at( 3 ) );
+}
+
+// end of file
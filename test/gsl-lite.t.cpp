@@ -104,6 +104,12 @@ CASE( "Presence of C++ language features" "[.stdlanguage]" )
 #else    
     gsl_ABSENT(  gsl_HAVE_NOEXCEPT );
 #endif
+
+#if gsl_HAVE_VARIADIC_TEMPLATES
+    gsl_PRESENT( gsl_HAVE_VARIADIC_TEMPLATES );
+#else
+    gsl_ABSENT(  gsl_HAVE_VARIADIC_TEMPLATES );
+#endif
 }
 
 CASE( "Presence of C++ library features" "[.stdlibrary]" )
@@ -157,16 +163,16 @@ int main( int argc, char * argv[] )
 }
 
 #if 0
-g++            -I../include/gsl -Dgsl_CONFIG_CONTRACT_VIOLATION_THROWS -o gsl-lite.t.exe gsl-lite.t.cpp assert.t.cpp at.t.cpp byte.t.cpp issue.t.cpp not_null.t.cpp owner.t.cpp span.t.cpp string_span.t.cpp util.t.cpp && gsl-lite.t.exe --pass
-g++ -std=c++98 -I../include/gsl -Dgsl_CONFIG_CONTRACT_VIOLATION_THROWS -o gsl-lite.t.exe gsl-lite.t.cpp assert.t.cpp at.t.cpp byte.t.cpp issue.t.cpp not_null.t.cpp owner.t.cpp span.t.cpp string_span.t.cpp util.t.cpp && gsl-lite.t.exe --pass
-g++ -std=c++03 -I../include/gsl -Dgsl_CONFIG_CONTRACT_VIOLATION_THROWS -o gsl-lite.t.exe gsl-lite.t.cpp assert.t.cpp at.t.cpp byte.t.cpp issue.t.cpp not_null.t.cpp owner.t.cpp span.t.cpp string_span.t.cpp util.t.cpp && gsl-lite.t.exe --pass
-g++ -std=c++0x -I../include/gsl -Dgsl_CONFIG_CONTRACT_VIOLATION_THROWS -o gsl-lite.t.exe gsl-lite.t.cpp assert.t.cpp at.t.cpp byte.t.cpp issue.t.cpp not_null.t.cpp owner.t.cpp span.t.cpp string_span.t.cpp util.t.cpp && gsl-lite.t.exe --pass
-g++ -std=c++11 -I../include/gsl -Dgsl_CONFIG_CONTRACT_VIOLATION_THROWS -o gsl-lite.t.exe gsl-lite.t.cpp assert.t.cpp at.t.cpp byte.t.cpp issue.t.cpp not_null.t.cpp owner.t.cpp span.t.cpp string_span.t.cpp util.t.cpp && gsl-lite.t.exe --pass
-g++ -std=c++14 -I../include/gsl -Dgsl_CONFIG_CONTRACT_VIOLATION_THROWS -o gsl-lite.t.exe gsl-lite.t.cpp assert.t.cpp at.t.cpp byte.t.cpp issue.t.cpp not_null.t.cpp owner.t.cpp span.t.cpp string_span.t.cpp util.t.cpp && gsl-lite.t.exe --pass
+g++            -I../include/gsl -Dgsl_CONFIG_CONTRACT_VIOLATION_THROWS -Dgsl_FEATURE_CONCURRENCY=1 -Dgsl_FEATURE_OS_FACILITIES=1 -o gsl-lite.t.exe gsl-lite.t.cpp arena.t.cpp assert.t.cpp at.t.cpp byte.t.cpp chunk_reader.t.cpp dyn_array.t.cpp issue.t.cpp mapped_file.t.cpp mirrored_ring.t.cpp md_span.t.cpp not_null.t.cpp object_pool.t.cpp owner.t.cpp parallel.t.cpp radix_sort.t.cpp small_buffer.t.cpp span.t.cpp span_sequence.t.cpp spsc_ring.t.cpp strided_span.t.cpp string_span.t.cpp util.t.cpp && gsl-lite.t.exe --pass
+g++ -std=c++98 -I../include/gsl -Dgsl_CONFIG_CONTRACT_VIOLATION_THROWS -Dgsl_FEATURE_CONCURRENCY=1 -Dgsl_FEATURE_OS_FACILITIES=1 -o gsl-lite.t.exe gsl-lite.t.cpp arena.t.cpp assert.t.cpp at.t.cpp byte.t.cpp chunk_reader.t.cpp dyn_array.t.cpp issue.t.cpp mapped_file.t.cpp mirrored_ring.t.cpp md_span.t.cpp not_null.t.cpp object_pool.t.cpp owner.t.cpp parallel.t.cpp radix_sort.t.cpp small_buffer.t.cpp span.t.cpp span_sequence.t.cpp spsc_ring.t.cpp strided_span.t.cpp string_span.t.cpp util.t.cpp && gsl-lite.t.exe --pass
+g++ -std=c++03 -I../include/gsl -Dgsl_CONFIG_CONTRACT_VIOLATION_THROWS -Dgsl_FEATURE_CONCURRENCY=1 -Dgsl_FEATURE_OS_FACILITIES=1 -o gsl-lite.t.exe gsl-lite.t.cpp arena.t.cpp assert.t.cpp at.t.cpp byte.t.cpp chunk_reader.t.cpp dyn_array.t.cpp issue.t.cpp mapped_file.t.cpp mirrored_ring.t.cpp md_span.t.cpp not_null.t.cpp object_pool.t.cpp owner.t.cpp parallel.t.cpp radix_sort.t.cpp small_buffer.t.cpp span.t.cpp span_sequence.t.cpp spsc_ring.t.cpp strided_span.t.cpp string_span.t.cpp util.t.cpp && gsl-lite.t.exe --pass
+g++ -std=c++0x -I../include/gsl -Dgsl_CONFIG_CONTRACT_VIOLATION_THROWS -Dgsl_FEATURE_CONCURRENCY=1 -Dgsl_FEATURE_OS_FACILITIES=1 -o gsl-lite.t.exe gsl-lite.t.cpp arena.t.cpp assert.t.cpp at.t.cpp byte.t.cpp chunk_reader.t.cpp dyn_array.t.cpp issue.t.cpp mapped_file.t.cpp mirrored_ring.t.cpp md_span.t.cpp not_null.t.cpp object_pool.t.cpp owner.t.cpp parallel.t.cpp radix_sort.t.cpp small_buffer.t.cpp span.t.cpp span_sequence.t.cpp spsc_ring.t.cpp strided_span.t.cpp string_span.t.cpp util.t.cpp && gsl-lite.t.exe --pass
+g++ -std=c++11 -I../include/gsl -Dgsl_CONFIG_CONTRACT_VIOLATION_THROWS -Dgsl_FEATURE_CONCURRENCY=1 -Dgsl_FEATURE_OS_FACILITIES=1 -o gsl-lite.t.exe gsl-lite.t.cpp arena.t.cpp assert.t.cpp at.t.cpp byte.t.cpp chunk_reader.t.cpp dyn_array.t.cpp issue.t.cpp mapped_file.t.cpp mirrored_ring.t.cpp md_span.t.cpp not_null.t.cpp object_pool.t.cpp owner.t.cpp parallel.t.cpp radix_sort.t.cpp small_buffer.t.cpp span.t.cpp span_sequence.t.cpp spsc_ring.t.cpp strided_span.t.cpp string_span.t.cpp util.t.cpp && gsl-lite.t.exe --pass
+g++ -std=c++14 -I../include/gsl -Dgsl_CONFIG_CONTRACT_VIOLATION_THROWS -Dgsl_FEATURE_CONCURRENCY=1 -Dgsl_FEATURE_OS_FACILITIES=1 -o gsl-lite.t.exe gsl-lite.t.cpp arena.t.cpp assert.t.cpp at.t.cpp byte.t.cpp chunk_reader.t.cpp dyn_array.t.cpp issue.t.cpp mapped_file.t.cpp mirrored_ring.t.cpp md_span.t.cpp not_null.t.cpp object_pool.t.cpp owner.t.cpp parallel.t.cpp radix_sort.t.cpp small_buffer.t.cpp span.t.cpp span_sequence.t.cpp spsc_ring.t.cpp strided_span.t.cpp string_span.t.cpp util.t.cpp && gsl-lite.t.exe --pass
 
-cl -EHsc -I../include/gsl -Dgsl_CONFIG_CONTRACT_VIOLATION_THROWS gsl-lite.t.cpp assert.t.cpp at.t.cpp byte.t.cpp issue.t.cpp not_null.t.cpp owner.t.cpp span.t.cpp string_span.t.cpp util.t.cpp && gsl-lite.t.exe --pass
+cl -EHsc -I../include/gsl -Dgsl_CONFIG_CONTRACT_VIOLATION_THROWS -Dgsl_FEATURE_CONCURRENCY=1 -Dgsl_FEATURE_OS_FACILITIES=1 gsl-lite.t.cpp arena.t.cpp assert.t.cpp at.t.cpp byte.t.cpp chunk_reader.t.cpp dyn_array.t.cpp issue.t.cpp mapped_file.t.cpp mirrored_ring.t.cpp md_span.t.cpp not_null.t.cpp object_pool.t.cpp owner.t.cpp parallel.t.cpp radix_sort.t.cpp small_buffer.t.cpp span.t.cpp span_sequence.t.cpp spsc_ring.t.cpp strided_span.t.cpp string_span.t.cpp util.t.cpp && gsl-lite.t.exe --pass
 
-cl -EHsc -I../include/gsl -Dgsl_CONFIG_CONTRACT_VIOLATION_THROWS -Dgsl_CONFIG_CONFIRMS_COMPILATION_ERRORS gsl-lite.t.cpp assert.t.cpp at.t.cpp byte.t.cpp issue.t.cpp not_null.t.cpp owner.t.cpp span.t.cpp string_span.t.cpp util.t.cpp && gsl-lite.t.exe --pass
+cl -EHsc -I../include/gsl -Dgsl_CONFIG_CONTRACT_VIOLATION_THROWS -Dgsl_FEATURE_CONCURRENCY=1 -Dgsl_FEATURE_OS_FACILITIES=1 -Dgsl_CONFIG_CONFIRMS_COMPILATION_ERRORS gsl-lite.t.cpp arena.t.cpp assert.t.cpp at.t.cpp byte.t.cpp chunk_reader.t.cpp dyn_array.t.cpp issue.t.cpp mapped_file.t.cpp mirrored_ring.t.cpp md_span.t.cpp not_null.t.cpp object_pool.t.cpp owner.t.cpp parallel.t.cpp radix_sort.t.cpp small_buffer.t.cpp span.t.cpp span_sequence.t.cpp spsc_ring.t.cpp strided_span.t.cpp string_span.t.cpp util.t.cpp && gsl-lite.t.exe --pass
 #endif
 
 // end of file
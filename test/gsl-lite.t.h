@@ -55,8 +55,8 @@ inline std::ostream & operator<<( std::ostream & os, byte b )
     return os << std::hex << "0x" << to_integer<int>(b); 
 }
 
-template< typename T >
-inline std::ostream & operator<<( std::ostream & os, span<T> s )
+template< typename T, size_t N >
+inline std::ostream & operator<<( std::ostream & os, span<T, N> s )
 {
     return os << "[", std::copy( s.begin(), s.end(), std::ostream_iterator<T>(os, ",") ), os << "]";
 }
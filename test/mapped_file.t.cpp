@@ -0,0 +1,229 @@
+//
+// gsl-lite is based on GSL: Guideline Support Library,
+// https://github.com/microsoft/gsl
+//
+// Copyright (c) 2015 Martin Moene
+// Copyright (c) 2015 Microsoft Corporation. All rights reserved.
+//
+// This code is licensed under the MIT License (MIT).
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "gsl-lite.t.h"
+
+#if gsl_HAVE_MMAP
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+// a temporary file with n ints 0, 1, 2, ..., removed on destruction:
+
+class temp_file
+{
+public:
+    explicit temp_file( int n )
+    {
+        char name[] = "/tmp/gsl-lite-mapped-XXXXXX";
+        int const fd = ::mkstemp( name );
+        ::close( fd );
+        path_ = name;
+
+        std::FILE * f = std::fopen( path(), "wb" );
+        for ( int i = 0; i < n; ++i )
+            std::fwrite( &i, sizeof( i ), 1, f );
+        std::fclose( f );
+    }
+
+    ~temp_file()
+    {
+        std::remove( path() );
+    }
+
+    char const * path() const
+    {
+        return path_.c_str();
+    }
+
+    int read( int index ) const
+    {
+        int value = -1;
+        std::FILE * f = std::fopen( path(), "rb" );
+        std::fseek( f, long( index * sizeof( int ) ), SEEK_SET );
+        if ( std::fread( &value, sizeof( value ), 1, f ) != 1 )
+            value = -1;
+        std::fclose( f );
+        return value;
+    }
+
+private:
+    std::string path_;
+};
+
+int page_ints()
+{
+    return static_cast<int>( ::sysconf( _SC_PAGESIZE ) / sizeof( int ) );
+}
+}
+#endif
+
+CASE( "mapped_file: Allows to map a file read-only as bytes" )
+{
+#if gsl_HAVE_MMAP
+    temp_file file( 100 );
+
+    mapped_file f( file.path() );
+
+    EXPECT( f.is_open() );
+    EXPECT( f.size() == 100 * sizeof( int ) );
+    EXPECT( f.file_size() == f.size() );
+    EXPECT( f.as_bytes().size() == f.size() );
+    EXPECT( to_integer<int>( f.as_bytes()[ sizeof( int ) ] ) == 1 );
+#else
+    EXPECT( !!"mapped_file is not available (no POSIX)" );
+#endif
+}
+
+CASE( "mapped_file: Allows to view the contents as a span of another type" )
+{
+#if gsl_HAVE_MMAP
+    temp_file file( 100 );
+
+    mapped_file f( file.path() );
+    span<const int> s = f.as_span<int>();
+
+    EXPECT( s.size() == 100u );
+    EXPECT( s[0]  ==  0 );
+    EXPECT( s[99] == 99 );
+#else
+    EXPECT( !!"mapped_file is not available (no POSIX)" );
+#endif
+}
+
+CASE( "mapped_file: Allows to modify a file mapped read-write" )
+{
+#if gsl_HAVE_MMAP
+    temp_file file( 100 );
+    {
+        mapped_file f( file.path(), mapped_file::read_write );
+
+        f.as_writeable_span<int>()[7] = 42;
+        f.flush();
+    }
+    EXPECT( file.read( 7 ) == 42 );
+#else
+    EXPECT( !!"mapped_file is not available (no POSIX)" );
+#endif
+}
+
+CASE( "mapped_file: Allows to map a range at any offset and to remap another range" )
+{
+#if gsl_HAVE_MMAP
+    int const n = 3 * page_ints();
+    temp_file file( n );
+
+    mapped_file f( file.path(), mapped_file::read_only, 5 * sizeof( int ), 10 * sizeof( int ) );
+
+    EXPECT( f.offset() == 5 * sizeof( int ) );
+    EXPECT( f.as_span<int>().size() == 10u );
+    EXPECT( f.as_span<int>()[0] == 5 );
+
+    f.remap( ( n - 3 ) * sizeof( int ), 3 * sizeof( int ) );
+
+    EXPECT( f.as_span<int>()[2] == n - 1 );
+#else
+    EXPECT( !!"mapped_file is not available (no POSIX)" );
+#endif
+}
+
+CASE( "mapped_file: Allows to give access hints and to request populated huge pages" )
+{
+#if gsl_HAVE_MMAP
+    temp_file file( 1000 );
+
+    mapped_file f( file.path(), mapped_file::read_only, mapped_file::populate | mapped_file::huge_pages );
+
+    EXPECT( f.advise( mapped_file::sequential ) );
+    EXPECT( f.advise( mapped_file::random     ) );
+    EXPECT( f.advise( mapped_file::willneed   ) );
+    EXPECT( f.as_span<int>()[999] == 999 );
+#else
+    EXPECT( !!"mapped_file is not available (no POSIX)" );
+#endif
+}
+
+CASE( "mapped_file: Allows to map an empty file" )
+{
+#if gsl_HAVE_MMAP
+    temp_file file( 0 );
+
+    mapped_file f( file.path() );
+
+    EXPECT( f.is_open() );
+    EXPECT( f.empty() );
+    EXPECT( f.as_bytes().size() == 0u );
+#else
+    EXPECT( !!"mapped_file is not available (no POSIX)" );
+#endif
+}
+
+CASE( "mapped_file: Allows to move a mapping (C++11)" )
+{
+#if gsl_HAVE_MMAP && gsl_CPP11_OR_GREATER
+    temp_file file( 10 );
+
+    mapped_file f( file.path() );
+    mapped_file g( std::move( f ) );
+
+    EXPECT( !f.is_open() );
+    EXPECT( g.as_span<int>()[9] == 9 );
+#else
+    EXPECT( !!"move-semantics are not available (no C++11)" );
+#endif
+}
+
+CASE( "mapped_file: Throws if the file cannot be opened" )
+{
+#if gsl_HAVE_MMAP
+    EXPECT_THROWS( mapped_file( "/nonexistent/gsl-lite" ) );
+#else
+    EXPECT( !!"mapped_file is not available (no POSIX)" );
+#endif
+}
+
+CASE( "mapped_file: Terminates on writable access to a read-only mapping" )
+{
+#if gsl_HAVE_MMAP
+    temp_file file( 10 );
+
+    mapped_file f( file.path() );
+
+    EXPECT_THROWS( f.as_writeable_bytes() );
+    EXPECT_THROWS( f.as_writeable_span<int>() );
+#else
+    EXPECT( !!"mapped_file is not available (no POSIX)" );
+#endif
+}
+
+CASE( "mapped_file: Terminates on a range beyond the end of the file" )
+{
+#if gsl_HAVE_MMAP
+    temp_file file( 10 );
+
+    mapped_file f( file.path() );
+
+    EXPECT_THROWS( f.remap( 0, 11 * sizeof( int ) ) );
+    EXPECT_THROWS( f.remap( 11 * sizeof( int ), 0 ) );
+#else
+    EXPECT( !!"mapped_file is not available (no POSIX)" );
+#endif
+}
+
+// end of file
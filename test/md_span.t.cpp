@@ -0,0 +1,220 @@
+//
+// gsl-lite is based on GSL: Guideline Support Library,
+// https://github.com/microsoft/gsl
+//
+// Copyright (c) 2015 Martin Moene
+// Copyright (c) 2015 Microsoft Corporation. All rights reserved.
+//
+// This code is licensed under the MIT License (MIT).
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "gsl-lite.t.h"
+
+CASE( "extents<>: Allows to mix static and dynamic extents" )
+{
+#if gsl_HAVE_VARIADIC_TEMPLATES
+    typedef extents< 2, dynamic_extent, 4 > ext;
+
+    ext e( 3 );
+
+    EXPECT( ext::rank()         == 3u );
+    EXPECT( ext::rank_dynamic() == 1u );
+    EXPECT( ext::static_extent( 1 ) == dynamic_extent );
+    EXPECT( e.extent( 0 ) == 2u );
+    EXPECT( e.extent( 1 ) == 3u );
+    EXPECT( e.extent( 2 ) == 4u );
+    EXPECT( e.size()      == 24u );
+    EXPECT( sizeof( ext ) == sizeof( size_t ) );
+#else
+    EXPECT( !!"md_span is not available (no C++11)" );
+#endif
+}
+
+CASE( "md_span<>: Allows to view a row-major matrix with static extents" )
+{
+#if gsl_HAVE_VARIADIC_TEMPLATES
+    int a[] = { 0, 1, 2, 10, 11, 12, };
+
+    md_span< int, extents<2, 3> > m( a );
+
+    EXPECT( m.rank() == 2u );
+    EXPECT( m.size() == 6u );
+    EXPECT( m( 0, 2 ) ==  2 );
+    EXPECT( m( 1, 0 ) == 10 );
+    EXPECT( m.stride( 0 ) == 3u );
+    EXPECT( m.stride( 1 ) == 1u );
+    EXPECT( sizeof( m ) == sizeof( int * ) );
+#else
+    EXPECT( !!"md_span is not available (no C++11)" );
+#endif
+}
+
+CASE( "md_span<>: Allows to view a row-major matrix with dynamic extents" )
+{
+#if gsl_HAVE_VARIADIC_TEMPLATES
+    std::vector<int> v( 12 );
+    for ( size_t i = 0; i < v.size(); ++i )
+        v[i] = static_cast<int>( i );
+
+    md_span< int, dextents<2> > m( v.data(), 3, 4 );
+
+    EXPECT( m.extent( 0 ) == 3u );
+    EXPECT( m.extent( 1 ) == 4u );
+    EXPECT( m( 2, 1 ) == 9 );
+
+    m( 2, 1 ) = 42;
+
+    EXPECT( v[9] == 42 );
+#else
+    EXPECT( !!"md_span is not available (no C++11)" );
+#endif
+}
+
+CASE( "md_span<>: Allows to view a column-major matrix" )
+{
+#if gsl_HAVE_VARIADIC_TEMPLATES
+    int a[] = { 0, 10, 1, 11, 2, 12, };
+
+    md_span< int, extents<2, dynamic_extent>, layout_left > m( a, 3 );
+
+    EXPECT( m( 0, 2 ) ==  2 );
+    EXPECT( m( 1, 0 ) == 10 );
+    EXPECT( m( 1, 2 ) == 12 );
+    EXPECT( m.stride( 0 ) == 1u );
+    EXPECT( m.stride( 1 ) == 2u );
+#else
+    EXPECT( !!"md_span is not available (no C++11)" );
+#endif
+}
+
+CASE( "md_span<>: Allows to view elements with a given stride per dimension" )
+{
+#if gsl_HAVE_VARIADIC_TEMPLATES
+    int a[] = { 0, -1, 1, -1, 2, -1, 10, -1, 11, -1, 12, -1, };
+    std::array<size_t, 2> const strides = {{ 6, 2 }};
+
+    md_span< int, dextents<2>, layout_stride > m( a, layout_stride::mapping< dextents<2> >( dextents<2>( 2, 3 ), strides ) );
+
+    EXPECT( m( 0, 2 ) ==  2 );
+    EXPECT( m( 1, 1 ) == 11 );
+    EXPECT( m.mapping().required_span_size() == 11u );
+    EXPECT( !m.is_contiguous() );
+#else
+    EXPECT( !!"md_span is not available (no C++11)" );
+#endif
+}
+
+CASE( "md_span<>: Allows to create a sub-view of a matrix" )
+{
+#if gsl_HAVE_VARIADIC_TEMPLATES
+    int a[4][5] = { { 0, 1, 2, 3, 4 }, { 10, 11, 12, 13, 14 }, { 20, 21, 22, 23, 24 }, { 30, 31, 32, 33, 34 }, };
+
+    md_span< int, extents<4, 5> > m( &a[0][0] );
+
+    std::array<size_t, 2> const offsets = {{ 1, 2 }};
+    std::array<size_t, 2> const sizes   = {{ 2, 3 }};
+
+    md_span< int, dextents<2>, layout_stride > tile = m.subspan( offsets, sizes );
+
+    EXPECT( tile.extent( 0 ) == 2u );
+    EXPECT( tile.extent( 1 ) == 3u );
+    EXPECT( tile( 0, 0 ) == 12 );
+    EXPECT( tile( 1, 2 ) == 24 );
+    EXPECT_THROWS( tile( 2, 0 ) );
+#else
+    EXPECT( !!"md_span is not available (no C++11)" );
+#endif
+}
+
+CASE( "md_span<>: Terminates on creation of a sub-view outside the matrix" )
+{
+#if gsl_HAVE_VARIADIC_TEMPLATES
+    int a[6] = { 0 };
+
+    md_span< int, extents<2, 3> > m( a );
+
+    std::array<size_t, 2> const offsets = {{ 1, 1 }};
+    std::array<size_t, 2> const sizes   = {{ 1, 3 }};
+
+    EXPECT_THROWS( m.subspan( offsets, sizes ) );
+#else
+    EXPECT( !!"md_span is not available (no C++11)" );
+#endif
+}
+
+CASE( "md_span<>: Terminates on access outside the extents" )
+{
+#if gsl_HAVE_VARIADIC_TEMPLATES
+    int a[6] = { 0 };
+
+    md_span< int, extents<2, 3> > m( a );
+
+    EXPECT_THROWS( m( 2, 0 ) );
+    EXPECT_THROWS( m( 0, 3 ) );
+    EXPECT_THROWS( m( -1, 0 ) );
+#else
+    EXPECT( !!"md_span is not available (no C++11)" );
+#endif
+}
+
+CASE( "md_span<>: Allows to create from a span of sufficient size" )
+{
+#if gsl_HAVE_VARIADIC_TEMPLATES
+    std::vector<int> v( 6 );
+
+    md_span< int, dextents<2> > m( span<int>( v ), 2, 3 );
+
+    EXPECT( m.data() == v.data() );
+    EXPECT( m.as_span().size() == 6u );
+#else
+    EXPECT( !!"md_span is not available (no C++11)" );
+#endif
+}
+
+CASE( "md_span<>: Terminates on creation from a span that is too small" )
+{
+#if gsl_HAVE_VARIADIC_TEMPLATES
+    std::vector<int> v( 5 );
+
+    EXPECT_THROWS( (md_span< int, dextents<2> >( span<int>( v ), 2, 3 )) );
+#else
+    EXPECT( !!"md_span is not available (no C++11)" );
+#endif
+}
+
+CASE( "md_span<>: Allows to convert to a view of const elements" )
+{
+#if gsl_HAVE_VARIADIC_TEMPLATES
+    int a[6] = { 0, 1, 2, 3, 4, 5, };
+
+    md_span< int, extents<2, 3> > m( a );
+    md_span< const int, extents<2, 3> > c = m;
+
+    EXPECT( c( 1, 2 ) == 5 );
+#else
+    EXPECT( !!"md_span is not available (no C++11)" );
+#endif
+}
+
+CASE( "md_span<>: Allows to view its elements as bytes" )
+{
+#if gsl_HAVE_VARIADIC_TEMPLATES
+    int a[6] = { 0 };
+
+    md_span< int, extents<2, 3> > m( a );
+
+    EXPECT( m.as_bytes().size() == sizeof( a ) );
+    EXPECT( m.as_writeable_bytes().data() == reinterpret_cast<byte *>( a ) );
+#else
+    EXPECT( !!"md_span is not available (no C++11)" );
+#endif
+}
+
+// end of file
@@ -0,0 +1,162 @@
+//
+// gsl-lite is based on GSL: Guideline Support Library,
+// https://github.com/microsoft/gsl
+//
+// Copyright (c) 2015 Martin Moene
+// Copyright (c) 2015 Microsoft Corporation. All rights reserved.
+//
+// This code is licensed under the MIT License (MIT).
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "gsl-lite.t.h"
+
+#if gsl_HAVE_MMAP
+
+namespace {
+
+size_t page_size()
+{
+    return static_cast<size_t>( ::sysconf( _SC_PAGESIZE ) );
+}
+
+// write n bytes first, first + 1, ... to the ring:
+
+void write( mirrored_ring & ring, size_t n, int first )
+{
+    span<byte> s = ring.writeable().first( n );
+
+    for ( size_t i = 0; i < n; ++i )
+        s[i] = to_byte( static_cast<unsigned char>( first + i ) );
+
+    ring.commit( n );
+}
+}
+#endif
+
+CASE( "mirrored_ring: Allows to create a ring of a multiple of the page size" )
+{
+#if gsl_HAVE_MMAP
+    mirrored_ring a( 1 ), b( page_size() + 1 );
+
+    EXPECT( a.capacity() == page_size() );
+    EXPECT( b.capacity() == 2 * page_size() );
+    EXPECT( a.empty() );
+    EXPECT( a.writeable().size() == a.capacity() );
+#else
+    EXPECT( !!"mirrored_ring is not available (no POSIX)" );
+#endif
+}
+
+CASE( "mirrored_ring: Allows to commit written bytes and to consume them" )
+{
+#if gsl_HAVE_MMAP
+    mirrored_ring ring( 100 );
+
+    write( ring, 10, 0 );
+
+    EXPECT( ring.size() == 10u );
+    EXPECT( ring.readable().size() == 10u );
+    EXPECT( to_integer<int>( ring.readable()[9] ) == 9 );
+
+    ring.consume( 4 );
+
+    EXPECT( ring.size() == 6u );
+    EXPECT( to_integer<int>( ring.readable()[0] ) == 4 );
+    EXPECT( ring.writeable().size() == ring.capacity() - 6 );
+#else
+    EXPECT( !!"mirrored_ring is not available (no POSIX)" );
+#endif
+}
+
+CASE( "mirrored_ring: Provides contiguous readable and writeable bytes across the end of the ring" )
+{
+#if gsl_HAVE_MMAP
+    mirrored_ring ring( 1 );
+    size_t const n = ring.capacity();
+
+    write( ring, n - 3, 0 );
+    ring.consume( n - 3 );
+
+    EXPECT( ring.writeable().size() == n );
+
+    write( ring, 6, 100 );
+
+    span<const byte> r = ring.readable();
+
+    EXPECT( r.size() == 6u );
+    EXPECT( to_integer<int>( r[2] ) == 102 );
+    EXPECT( to_integer<int>( r[3] ) == 103 );
+    EXPECT( to_integer<int>( r[5] ) == 105 );
+
+    // the bytes past the end are the bytes at the start of the ring:
+
+    ring.consume( 3 );
+
+    EXPECT( to_integer<int>( ring.readable()[0] ) == 103 );
+    EXPECT( ring.readable().data() + n == r.data() + 3 );
+    EXPECT( ring.writeable().size() == n - 3 );
+#else
+    EXPECT( !!"mirrored_ring is not available (no POSIX)" );
+#endif
+}
+
+CASE( "mirrored_ring: Allows to fill the ring completely" )
+{
+#if gsl_HAVE_MMAP
+    mirrored_ring ring( 1 );
+
+    ring.commit( ring.capacity() );
+
+    EXPECT( ring.full() );
+    EXPECT( ring.writeable().empty() );
+
+    ring.consume( 1 );
+    ring.commit( 1 );
+
+    EXPECT( ring.readable().size() == ring.capacity() );
+
+    ring.clear();
+
+    EXPECT( ring.empty() );
+#else
+    EXPECT( !!"mirrored_ring is not available (no POSIX)" );
+#endif
+}
+
+CASE( "mirrored_ring: Allows to move a ring (C++11)" )
+{
+#if gsl_HAVE_MMAP && gsl_CPP11_OR_GREATER
+    mirrored_ring a( 1 );
+    write( a, 5, 0 );
+
+    mirrored_ring b( std::move( a ) );
+
+    EXPECT( a.capacity() == 0u );
+    EXPECT( b.size() == 5u );
+    EXPECT( to_integer<int>( b.readable()[4] ) == 4 );
+#else
+    EXPECT( !!"move-semantics are not available (no C++11)" );
+#endif
+}
+
+CASE( "mirrored_ring: Terminates on committing or consuming more than available" )
+{
+#if gsl_HAVE_MMAP
+    mirrored_ring ring( 1 );
+
+    EXPECT_THROWS( ring.consume( 1 ) );
+    EXPECT_THROWS( ring.commit( ring.capacity() + 1 ) );
+    EXPECT_THROWS( mirrored_ring( 0 ) );
+#else
+    EXPECT( !!"mirrored_ring is not available (no POSIX)" );
+#endif
+}
+
+// end of file
@@ -0,0 +1,211 @@
+//
+// gsl-lite is based on GSL: Guideline Support Library,
+// https://github.com/microsoft/gsl
+//
+// Copyright (c) 2015 Martin Moene
+// Copyright (c) 2015 Microsoft Corporation. All rights reserved.
+//
+// This code is licensed under the MIT License (MIT).
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "gsl-lite.t.h"
+
+#if gsl_HAVE_THREAD
+
+#include <thread>
+
+namespace {
+
+// counts live instances, throws on construction with a negative value:
+
+struct item
+{
+    static std::atomic<int> live;
+
+    int value;
+
+    item( int value_, int offset = 0 )
+        : value( value_ + offset )
+    {
+        if ( value < 0 )
+            throw std::runtime_error( "item" );
+        ++live;
+    }
+
+    ~item()
+    {
+        --live;
+    }
+};
+
+std::atomic<int> item::live( 0 );
+
+// acquire and release n items in rounds of up to 10 outstanding ones:
+
+void churn( object_pool<item> & pool, int n )
+{
+    std::vector< item * > held;
+
+    for ( int i = 0; i < n; ++i )
+    {
+        held.push_back( pool.acquire( i ) );
+
+        if ( held.size() == 10 )
+        {
+            for ( size_t k = 0; k < held.size(); ++k )
+                pool.release( held[k] );
+            held.clear();
+        }
+    }
+
+    for ( size_t k = 0; k < held.size(); ++k )
+        pool.release( held[k] );
+}
+}
+#endif
+
+CASE( "object_pool<>: Allows to acquire an object as not_null and to release it" )
+{
+#if gsl_HAVE_THREAD
+    object_pool<item> pool;
+
+    not_null<item *> p = pool.acquire( 40, 2 );
+
+    EXPECT( p->value == 42 );
+    EXPECT( item::live == 1 );
+
+    pool.release( p );
+
+    EXPECT( item::live == 0 );
+#else
+    EXPECT( !!"object_pool is not available (no C++11)" );
+#endif
+}
+
+CASE( "object_pool<>: Allows to reuse the memory of a released object" )
+{
+#if gsl_HAVE_THREAD
+    object_pool<item> pool;
+
+    item * p = pool.acquire( 1 );
+    pool.release( p );
+
+    not_null<item *> q = pool.acquire( 2 );
+
+    EXPECT( q.get() == p );
+
+    pool.release( q );
+#else
+    EXPECT( !!"object_pool is not available (no C++11)" );
+#endif
+}
+
+CASE( "object_pool<>: Counts hits and misses of the thread's cache" )
+{
+#if gsl_HAVE_THREAD
+    object_pool<item> pool( 4 );
+    std::vector< item * > held;
+
+    for ( int i = 0; i < 6; ++i )
+        held.push_back( pool.acquire( i ) );
+
+    object_pool_statistics const s = pool.statistics();
+
+    for ( size_t k = 0; k < held.size(); ++k )
+        pool.release( held[k] );
+
+    EXPECT( s.misses      == 2u );
+    EXPECT( s.hits        == 4u );
+    EXPECT( s.allocations == 8u );
+    EXPECT( s.flushes     == 0u );
+#else
+    EXPECT( !!"object_pool is not available (no C++11)" );
+#endif
+}
+
+CASE( "object_pool<>: Returns slots to the pool in batches" )
+{
+#if gsl_HAVE_THREAD
+    object_pool<item> pool( 4 );
+    std::vector< item * > held;
+
+    for ( int i = 0; i < 8; ++i )
+        held.push_back( pool.acquire( i ) );
+
+    for ( size_t k = 0; k < held.size(); ++k )
+        pool.release( held[k] );
+
+    EXPECT( pool.statistics().flushes == 1u );
+#else
+    EXPECT( !!"object_pool is not available (no C++11)" );
+#endif
+}
+
+CASE( "object_pool<>: Keeps the slot if construction of the object throws" )
+{
+#if gsl_HAVE_THREAD
+    object_pool<item> pool( 1 );
+
+    EXPECT_THROWS( pool.acquire( -1 ) );
+
+    pool.release( pool.acquire( 1 ) );
+
+    EXPECT( pool.statistics().allocations == 1u );
+#else
+    EXPECT( !!"object_pool is not available (no C++11)" );
+#endif
+}
+
+CASE( "object_pool<>: Allows to acquire and release objects from several threads" )
+{
+#if gsl_HAVE_THREAD
+    int const n = 1000;
+    {
+        object_pool<item> pool( 8 );
+
+        std::thread a( churn, std::ref( pool ), n ), b( churn, std::ref( pool ), n ), c( churn, std::ref( pool ), n );
+        a.join(); b.join(); c.join();
+
+        object_pool_statistics const s = pool.statistics();
+
+        EXPECT( item::live == 0 );
+        EXPECT( s.hits + s.misses == 3u * n );
+        EXPECT( s.allocations <= 3u * 64 );
+
+        // slots of the exited threads are back in the pool:
+
+        churn( pool, n );
+
+        EXPECT( pool.statistics().allocations == s.allocations );
+    }
+    EXPECT( item::live == 0 );
+#else
+    EXPECT( !!"object_pool is not available (no C++11)" );
+#endif
+}
+
+CASE( "object_pool<>: Allows a thread that used a pool to outlive it" )
+{
+#if gsl_HAVE_THREAD
+    std::unique_ptr< object_pool<item> > pool( new object_pool<item>() );
+
+    churn( *pool, 20 );
+    pool.reset();
+
+    object_pool<item> other;
+    churn( other, 20 );
+
+    EXPECT( item::live == 0 );
+#else
+    EXPECT( !!"object_pool is not available (no C++11)" );
+#endif
+}
+
+// end of file
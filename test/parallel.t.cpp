@@ -0,0 +1,319 @@
+//
+// gsl-lite is based on GSL: Guideline Support Library,
+// https://github.com/microsoft/gsl
+//
+// Copyright (c) 2015 Martin Moene
+// Copyright (c) 2015 Microsoft Corporation. All rights reserved.
+//
+// This code is licensed under the MIT License (MIT).
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "gsl-lite.t.h"
+
+#if gsl_HAVE_THREAD
+
+#include <numeric>
+
+namespace {
+
+std::vector<int> iota( size_t n )
+{
+    std::vector<int> v( n );
+    for ( size_t i = 0; i < n; ++i )
+        v[i] = static_cast<int>( i );
+    return v;
+}
+
+// n pseudo-random values below limit:
+
+std::vector<int> random_values( size_t n, int limit )
+{
+    std::vector<int> v( n );
+    unsigned x = 12345;
+    for ( size_t i = 0; i < n; ++i )
+    {
+        x = x * 1103515245u + 12345u;
+        v[i] = static_cast<int>( ( x >> 8 ) % static_cast<unsigned>( limit ) );
+    }
+    return v;
+}
+
+struct concatenate
+{
+    std::string operator()( std::string const & a, std::string const & b ) const
+    {
+        return a + b;
+    }
+};
+}
+#endif
+
+CASE( "thread_pool: Allows to run each chunk exactly once" )
+{
+#if gsl_HAVE_THREAD
+    thread_pool pool( 3 );
+    std::vector< std::atomic<int> > runs( 1000 );
+    std::atomic<bool> valid_participant( true );
+
+    for ( size_t i = 0; i < runs.size(); ++i )
+        runs[i] = 0;
+
+    pool.run( runs.size(), [&]( size_t chunk, size_t participant )
+    {
+        ++runs[ chunk ];
+        if ( participant >= pool.concurrency() )
+            valid_participant = false;
+    } );
+
+    bool once = true;
+    for ( size_t i = 0; i < runs.size(); ++i )
+        once = once && runs[i] == 1;
+
+    EXPECT( pool.concurrency() == 4u );
+    EXPECT( once );
+    EXPECT( valid_participant );
+#else
+    EXPECT( !!"thread_pool is not available (no C++11)" );
+#endif
+}
+
+CASE( "thread_pool: Allows to run chunks on the calling thread only" )
+{
+#if gsl_HAVE_THREAD
+    thread_pool pool( 0 );
+    std::thread::id const caller = std::this_thread::get_id();
+    bool on_caller = true;
+    int count = 0;
+
+    pool.run( 10, [&]( size_t, size_t ) { on_caller = on_caller && std::this_thread::get_id() == caller; ++count; } );
+
+    EXPECT( pool.concurrency() == 1u );
+    EXPECT( on_caller );
+    EXPECT( count == 10 );
+#else
+    EXPECT( !!"thread_pool is not available (no C++11)" );
+#endif
+}
+
+CASE( "thread_pool: Allows to run from within a chunk" )
+{
+#if gsl_HAVE_THREAD
+    thread_pool pool( 2 );
+    std::atomic<int> count( 0 );
+
+    pool.run( 8, [&]( size_t, size_t )
+    {
+        pool.run( 8, [&]( size_t, size_t ) { ++count; } );
+    } );
+
+    EXPECT( count == 64 );
+#else
+    EXPECT( !!"thread_pool is not available (no C++11)" );
+#endif
+}
+
+CASE( "thread_pool: Rethrows an exception of a chunk and remains usable" )
+{
+#if gsl_HAVE_THREAD
+    thread_pool pool( 2 );
+    std::atomic<int> count( 0 );
+
+    EXPECT_THROWS_AS( pool.run( 100, []( size_t chunk, size_t ) { if ( chunk == 42 ) throw std::runtime_error( "chunk" ); } ), std::runtime_error );
+
+    pool.run( 100, [&]( size_t, size_t ) { ++count; } );
+
+    EXPECT( count == 100 );
+#else
+    EXPECT( !!"thread_pool is not available (no C++11)" );
+#endif
+}
+
+CASE( "parallel_for_each: Allows to call a function for each element" )
+{
+#if gsl_HAVE_THREAD
+    thread_pool pool( 3 );
+    std::vector<int> v = iota( 100 * 1000 );
+
+    parallel_for_each( pool, span<int>( v ), []( int & x ) { x *= 2; }, 1000 );
+
+    EXPECT( v[0] == 0 );
+    EXPECT( v[12345] == 24690 );
+    EXPECT( v[99999] == 199998 );
+#else
+    EXPECT( !!"parallel_for_each is not available (no C++11)" );
+#endif
+}
+
+CASE( "parallel_transform: Allows to transform a span into another" )
+{
+#if gsl_HAVE_THREAD
+    std::vector<int> in = iota( 50 * 1000 );
+    std::vector<long> out( in.size() );
+
+    parallel_transform( span<const int>( in ), span<long>( out ), []( int x ) { return 3L * x; }, 100 );
+
+    bool all = true;
+    for ( size_t i = 0; i < out.size(); ++i )
+        all = all && out[i] == 3L * static_cast<long>( i );
+
+    EXPECT( all );
+#else
+    EXPECT( !!"parallel_transform is not available (no C++11)" );
+#endif
+}
+
+CASE( "parallel_reduce: Allows to combine the elements of a span" )
+{
+#if gsl_HAVE_THREAD
+    thread_pool pool( 3 );
+    std::vector<int> v = iota( 100 * 1000 + 3 );
+
+    long long const expected = std::accumulate( v.begin(), v.end(), 0LL );
+
+    EXPECT( parallel_reduce( pool, span<const int>( v ), 0LL, std::plus<long long>(), 777 ) == expected );
+    EXPECT( parallel_reduce( pool, span<const int>( v ), 0LL, std::plus<long long>() ) == expected );
+    EXPECT( parallel_reduce( pool, span<const int>(), 5LL, std::plus<long long>() ) == 5 );
+#else
+    EXPECT( !!"parallel_reduce is not available (no C++11)" );
+#endif
+}
+
+CASE( "parallel_reduce: Allows to combine the elements in order" )
+{
+#if gsl_HAVE_THREAD
+    thread_pool pool( 3 );
+    std::vector<std::string> letters;
+    std::string expected;
+
+    for ( int i = 0; i < 2000; ++i )
+    {
+        letters.push_back( std::string( 1, static_cast<char>( 'a' + i % 26 ) ) );
+        expected += letters.back();
+    }
+
+    EXPECT( parallel_reduce( pool, span<const std::string>( letters ), std::string( ">" ), concatenate(), in_order, 7 ) == ">" + expected );
+#else
+    EXPECT( !!"parallel_reduce is not available (no C++11)" );
+#endif
+}
+
+CASE( "parallel_reduce: Yields the same result in order for pools of any size and spans at any alignment" )
+{
+#if gsl_HAVE_THREAD
+    size_t const n = 100 * 1000;
+    std::vector<float> a( n ), b( n + 1 );
+
+    for ( size_t i = 0; i < n; ++i )
+        a[i] = b[i + 1] = i % 7 == 0 ? 1e7f : 0.1f * float( i % 13 );
+
+    thread_pool serial( 0 ), few( 2 ), many( 7 );
+
+    float const expected = parallel_reduce( serial, span<const float>( a ), 0.0f, std::plus<float>(), in_order );
+
+    EXPECT( parallel_reduce( few,  span<const float>( a ), 0.0f, std::plus<float>(), in_order ) == expected );
+    EXPECT( parallel_reduce( many, span<const float>( a ), 0.0f, std::plus<float>(), in_order ) == expected );
+    EXPECT( parallel_reduce( many, span<const float>( b ).subspan( 1 ), 0.0f, std::plus<float>(), in_order ) == expected );
+    EXPECT( parallel_reduce( many, span<const float>( a ), 0.0f, std::plus<float>(), in_order, 1000 )
+         == parallel_reduce( few,  span<const float>( b ).subspan( 1 ), 0.0f, std::plus<float>(), in_order, 1000 ) );
+#else
+    EXPECT( !!"parallel_reduce is not available (no C++11)" );
+#endif
+}
+
+CASE( "parallel_transform: Terminates on spans of different sizes" )
+{
+#if gsl_HAVE_THREAD
+    std::vector<int> in( 10 ), out( 9 );
+
+    EXPECT_THROWS( parallel_transform( span<const int>( in ), span<int>( out ), []( int x ) { return x; } ) );
+#else
+    EXPECT( !!"parallel_transform is not available (no C++11)" );
+#endif
+}
+
+CASE( "parallel_sort: Allows to sort a span in place" )
+{
+#if gsl_HAVE_THREAD
+    size_t const sizes[] = { 0, 1, 1000, 100003, };
+
+    for ( size_t workers = 0; workers < 4; ++workers )
+    {
+        thread_pool pool( workers );
+
+        for ( size_t k = 0; k < gsl_DIMENSION_OF( sizes ); ++k )
+        {
+            std::vector<int> v = random_values( sizes[k], 1000 * 1000 );
+            std::vector<int> expected( v );
+            std::sort( expected.begin(), expected.end() );
+
+            parallel_sort( pool, span<int>( v ) );
+
+            EXPECT( std::equal( v.begin(), v.end(), expected.begin() ) );
+        }
+    }
+#else
+    EXPECT( !!"parallel_sort is not available (no C++11)" );
+#endif
+}
+
+CASE( "parallel_sort: Allows to sort a span with a scratch span" )
+{
+#if gsl_HAVE_THREAD
+    size_t const sizes[] = { 0, 1, 1000, 100003, };
+
+    for ( size_t workers = 0; workers < 4; ++workers )
+    {
+        thread_pool pool( workers );
+
+        for ( size_t k = 0; k < gsl_DIMENSION_OF( sizes ); ++k )
+        {
+            std::vector<int> v = random_values( sizes[k], 1000 * 1000 ), scratch( sizes[k] + 1 );
+            std::vector<int> expected( v );
+            std::sort( expected.begin(), expected.end() );
+
+            parallel_sort( pool, span<int>( v ), span<int>( scratch ) );
+
+            EXPECT( std::equal( v.begin(), v.end(), expected.begin() ) );
+        }
+    }
+#else
+    EXPECT( !!"parallel_sort is not available (no C++11)" );
+#endif
+}
+
+CASE( "parallel_sort: Allows to sort with a comparison and many equal elements" )
+{
+#if gsl_HAVE_THREAD
+    std::vector<int> v = random_values( 200 * 1000, 10 ), w( v ), scratch( v.size() );
+    std::vector<int> expected( v );
+    std::sort( expected.begin(), expected.end(), std::greater<int>() );
+
+    parallel_sort( span<int>( v ), std::greater<int>() );
+    parallel_sort( span<int>( w ), span<int>( scratch ), std::greater<int>() );
+
+    EXPECT( std::equal( v.begin(), v.end(), expected.begin() ) );
+    EXPECT( std::equal( w.begin(), w.end(), expected.begin() ) );
+#else
+    EXPECT( !!"parallel_sort is not available (no C++11)" );
+#endif
+}
+
+CASE( "parallel_sort: Terminates on a scratch span smaller than the span" )
+{
+#if gsl_HAVE_THREAD
+    std::vector<int> v( 10 ), scratch( 9 );
+
+    EXPECT_THROWS( parallel_sort( span<int>( v ), span<int>( scratch ) ) );
+#else
+    EXPECT( !!"parallel_sort is not available (no C++11)" );
+#endif
+}
+
+// end of file
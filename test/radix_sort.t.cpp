@@ -0,0 +1,156 @@
+//
+// gsl-lite is based on GSL: Guideline Support Library,
+// https://github.com/microsoft/gsl
+//
+// Copyright (c) 2015 Martin Moene
+// Copyright (c) 2015 Microsoft Corporation. All rights reserved.
+//
+// This code is licensed under the MIT License (MIT).
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "gsl-lite.t.h"
+
+namespace {
+
+struct record
+{
+    int key;
+    int order;
+};
+
+// n pseudo-random values:
+
+std::vector<unsigned> random_bits( size_t n )
+{
+    std::vector<unsigned> v( n );
+    unsigned x = 2463534242u;
+    for ( size_t i = 0; i < n; ++i )
+    {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        v[i] = x;
+    }
+    return v;
+}
+
+template< class T >
+bool radix_sorts( std::vector<T> v )
+{
+    std::vector<T> scratch( v.size() ), expected( v );
+    std::sort( expected.begin(), expected.end() );
+
+    radix_sort( span<T>( v ), span<T>( scratch ) );
+
+    return std::equal( v.begin(), v.end(), expected.begin() );
+}
+}
+
+CASE( "radix_sort: Allows to sort unsigned integers" )
+{
+    std::vector<unsigned> v = random_bits( 10000 );
+    std::vector<unsigned long long> w( v.size() );
+    std::vector<unsigned short> x( v.size() );
+
+    for ( size_t i = 0; i < v.size(); ++i )
+    {
+        w[i] = static_cast<unsigned long long>( v[i] ) << 32 | v[ v.size() - 1 - i ];
+        x[i] = static_cast<unsigned short>( v[i] );
+    }
+
+    EXPECT( radix_sorts( v ) );
+    EXPECT( radix_sorts( w ) );
+    EXPECT( radix_sorts( x ) );
+}
+
+CASE( "radix_sort: Allows to sort signed integers" )
+{
+    std::vector<unsigned> const bits = random_bits( 10000 );
+    std::vector<int> v( bits.size() );
+    std::vector<long long> w( bits.size() );
+    std::vector<signed char> x( bits.size() );
+
+    for ( size_t i = 0; i < bits.size(); ++i )
+    {
+        v[i] = static_cast<int>( bits[i] );
+        w[i] = static_cast<long long>( v[i] ) * 1000;
+        x[i] = static_cast<signed char>( v[i] % 100 );
+    }
+
+    EXPECT( radix_sorts( v ) );
+    EXPECT( radix_sorts( w ) );
+    EXPECT( radix_sorts( x ) );
+}
+
+CASE( "radix_sort: Allows to sort floating point numbers" )
+{
+    std::vector<unsigned> const bits = random_bits( 10000 );
+    std::vector<float> v( bits.size() );
+    std::vector<double> w( bits.size() );
+
+    for ( size_t i = 0; i < bits.size(); ++i )
+    {
+        v[i] = static_cast<float>( static_cast<int>( bits[i] ) ) / 1e6f;
+        w[i] = 1.0 / static_cast<int>( bits[i] | 1 );
+    }
+    v[0] = 0.0f; v[1] = -1e-30f; v[2] = 1e30f;
+
+    EXPECT( radix_sorts( v ) );
+    EXPECT( radix_sorts( w ) );
+}
+
+CASE( "radix_sort: Allows to sort structs by a member key, keeping the order of equal keys" )
+{
+    std::vector<unsigned> const bits = random_bits( 1000 );
+    std::vector<record> v( bits.size() ), scratch( bits.size() );
+
+    for ( size_t i = 0; i < v.size(); ++i )
+    {
+        v[i].key   = static_cast<int>( bits[i] % 50 ) - 25;
+        v[i].order = static_cast<int>( i );
+    }
+
+    radix_sort( span<record>( v ), span<record>( scratch ), &record::key );
+
+    bool sorted = true;
+    for ( size_t i = 1; i < v.size(); ++i )
+        sorted = sorted && ( v[i-1].key < v[i].key || ( v[i-1].key == v[i].key && v[i-1].order < v[i].order ) );
+
+    EXPECT( sorted );
+}
+
+CASE( "radix_sort: Skips the passes of bytes that are the same for all keys" )
+{
+    unsigned v[] = { 0x1234ff03, 0x1234ff01, 0x1234ff02, };
+    unsigned scratch[3] = { 0, 0, 0, };
+
+    radix_sort( span<unsigned>( v ), span<unsigned>( scratch ) );
+
+    // one pass into scratch, copied back:
+
+    EXPECT( v[0] == 0x1234ff01u );
+    EXPECT( v[2] == 0x1234ff03u );
+    EXPECT( scratch[0] == 0x1234ff01u );
+
+    unsigned same[] = { 7, 7, };
+    unsigned untouched[] = { 0, 0, };
+
+    radix_sort( span<unsigned>( same ), span<unsigned>( untouched ) );
+
+    EXPECT( untouched[0] == 0u );
+}
+
+CASE( "radix_sort: Terminates on a scratch span smaller than the span" )
+{
+    int v[] = { 3, 2, 1, };
+    int scratch[2];
+
+    EXPECT_THROWS( radix_sort( span<int>( v ), span<int>( scratch ) ) );
+}
+
+// end of file
@@ -0,0 +1,222 @@
+//
+// gsl-lite is based on GSL: Guideline Support Library,
+// https://github.com/microsoft/gsl
+//
+// Copyright (c) 2015 Martin Moene
+// Copyright (c) 2015 Microsoft Corporation. All rights reserved.
+//
+// This code is licensed under the MIT License (MIT).
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "gsl-lite.t.h"
+
+namespace {
+
+// counts live instances, throws on the construction of instance number throw_at:
+
+struct tracked
+{
+    static int live;
+    static int throw_at;
+    static int constructed;
+
+    tracked()
+    {
+        if ( ++constructed == throw_at )
+            throw std::runtime_error( "tracked" );
+        ++live;
+    }
+
+    tracked( tracked const & )
+    {
+        ++live;
+    }
+
+    ~tracked()
+    {
+        --live;
+    }
+};
+
+int tracked::live        = 0;
+int tracked::throw_at    = 0;
+int tracked::constructed = 0;
+
+int sum( span<const int> s )
+{
+    int result = 0;
+    for ( size_t i = 0; i < s.size(); ++i )
+        result += s[i];
+    return result;
+}
+
+void fill( span<int> s, int value )
+{
+    for ( size_t i = 0; i < s.size(); ++i )
+        s[i] = value;
+}
+}
+
+CASE( "small_buffer<>: Allows to default-construct an empty buffer" )
+{
+    small_buffer<int, 4> b;
+
+    EXPECT( b.empty() );
+    EXPECT( b.is_inline() );
+    EXPECT( b.begin() == b.end() );
+    EXPECT( b.inline_capacity() == 4u );
+}
+
+CASE( "small_buffer<>: Allows to keep up to N elements inline" )
+{
+    small_buffer<int, 4> b( 4 );
+
+    EXPECT( b.size() == 4u );
+    EXPECT( b.is_inline() );
+    EXPECT( b[0] == 0 );
+    EXPECT( b[3] == 0 );
+    EXPECT( reinterpret_cast<size_t>( b.data()     ) >= reinterpret_cast<size_t>( &b     ) );
+    EXPECT( reinterpret_cast<size_t>( b.data() + 4 ) <= reinterpret_cast<size_t>( &b + 1 ) );
+}
+
+CASE( "small_buffer<>: Allows to store more than N elements on the heap" )
+{
+    small_buffer<int, 4> b( 5, 7 );
+
+    EXPECT( b.size() == 5u );
+    EXPECT( !b.is_inline() );
+    EXPECT( b[4] == 7 );
+}
+
+CASE( "small_buffer<>: Allows to construct a buffer of default-initialized elements" )
+{
+    tracked::live = 0;
+    {
+        small_buffer<tracked, 4> a( 3, with_default_init );
+        small_buffer<tracked, 4> b( 6, with_default_init );
+
+        EXPECT( tracked::live == 9 );
+    }
+    EXPECT( tracked::live == 0 );
+}
+
+CASE( "small_buffer<>: Allows to construct a buffer as a copy of a span" )
+{
+    int arr[] = { 1, 2, 3, };
+
+    small_buffer<int, 2> b( as_span( arr ) );
+
+    EXPECT( b.size() == 3u );
+    EXPECT( b[2] == 3 );
+}
+
+CASE( "small_buffer<>: Allows to convert implicitly to a span" )
+{
+#if gsl_HAVE_CONSTRAINED_SPAN_CONTAINER_CTOR || gsl_HAVE_UNCONSTRAINED_SPAN_CONTAINER_CTOR
+    small_buffer<int, 8> b( 4 );
+
+    fill( b, 3 );
+
+    small_buffer<int, 8> const & c = b;
+
+    EXPECT( sum( c ) == 12 );
+#else
+    EXPECT( !!"(un)constrained construction from container is not available" );
+#endif
+}
+
+CASE( "small_buffer<>: Allows to create a span with as_span()" )
+{
+    small_buffer<int, 8> b( 4 );
+    small_buffer<int, 8> const & c = b;
+
+    fill( as_span( b ), 2 );
+
+    EXPECT( sum( as_span( c ) ) == 8 );
+    EXPECT( as_span( c ).data() == b.data() );
+}
+
+CASE( "small_buffer<>: Allows to copy-construct and copy-assign" )
+{
+    small_buffer<int, 4> a( 3, 1 );
+    small_buffer<int, 4> b( 6, 2 );
+    small_buffer<int, 4> c( a );
+    small_buffer<int, 4> d;
+
+    d = b;
+    c[0] = 3;
+
+    EXPECT( a[0] == 1 );
+    EXPECT( c[0] == 3 );
+    EXPECT( c.is_inline() );
+    EXPECT( d.size() == 6u );
+    EXPECT( d[5] == 2 );
+    EXPECT( d.data() != b.data() );
+
+    d = a;
+
+    EXPECT( d.size() == 3u );
+    EXPECT( d.is_inline() );
+}
+
+CASE( "small_buffer<>: Allows to move-construct and move-assign (C++11)" )
+{
+#if gsl_CPP11_OR_GREATER
+    small_buffer<int, 4> a( 6, 1 );
+    int * const p = a.data();
+
+    small_buffer<int, 4> b( std::move( a ) );
+
+    EXPECT( b.data() == p );
+    EXPECT( a.empty() );
+    EXPECT( a.is_inline() );
+
+    small_buffer<int, 4> c( 2, 5 );
+    small_buffer<int, 4> d( std::move( c ) );
+
+    EXPECT( d.is_inline() );
+    EXPECT( d[1] == 5 );
+    EXPECT( c.empty() );
+
+    d = std::move( b );
+
+    EXPECT( d.data() == p );
+    EXPECT( b.empty() );
+#else
+    EXPECT( !!"move-semantics are not available (no C++11)" );
+#endif
+}
+
+CASE( "small_buffer<>: Destroys the constructed elements if construction of an element throws" )
+{
+    tracked::live        = 0;
+    tracked::constructed = 0;
+    tracked::throw_at    = 3;
+
+    EXPECT_THROWS( (small_buffer<tracked, 4>( 3 )) );
+    EXPECT( tracked::live == 0 );
+
+    tracked::constructed = 0;
+
+    EXPECT_THROWS( (small_buffer<tracked, 4>( 5 )) );
+    EXPECT( tracked::live == 0 );
+
+    tracked::throw_at = 0;
+}
+
+CASE( "small_buffer<>: Terminates on access outside the buffer" )
+{
+    small_buffer<int, 4> b( 3 );
+
+    EXPECT_THROWS( b[3] );
+    EXPECT_THROWS( b.at( 3 ) );
+}
+
+// end of file
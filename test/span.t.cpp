@@ -137,6 +137,11 @@ CASE( "span<>: Terminates access outside the span" )
     EXPECT_THROWS(   F::blow_at(3) );
 }
 
+CASE( "span<>: Has the size of two pointers for either storage layout" )
+{
+    EXPECT( sizeof( span<int> ) == 2 * sizeof( int * ) );
+}
+
 CASE( "span<>: Allows default construction" )
 {
     span<int> v;
@@ -810,6 +815,272 @@ CASE( "span<>: Allows to compare empty spans as equal" )
 #endif
 }
 
+CASE( "span<>: Allows to compare long spans of byte, that differ anywhere" )
+{
+    gsl::byte a[40];
+    gsl::byte b[40];
+
+    for ( size_t i = 0; i < 40; ++i )
+    {
+        a[i] = b[i] = to_byte( i );
+    }
+
+    span<gsl::byte> va( a );
+    span<gsl::byte> vb( b );
+
+    EXPECT( va == vb );
+
+    for ( size_t k = 0; k < 40; ++k )
+    {
+        b[k] = to_byte( 0xFF );
+        EXPECT( va != vb );
+        EXPECT( va <  vb );
+        b[k] = a[k];
+    }
+}
+
+CASE( "span<>: Allows to compare spans of signed integers consistent with element-wise comparison" )
+{
+    int         a[] = { 1, -2,  3, };
+    int         b[] = { 1,  2, -3, };
+    signed char c[] = { 'a', -1, };
+    signed char d[] = { 'a',  1, };
+
+    EXPECT( span<int>( a ) < span<int>( b ) );
+    EXPECT( span<signed char>( c ) < span<signed char>( d ) );
+}
+
+CASE( "span<>: Allows to compare spans of a type without a unique object representation" )
+{
+    double a[] = { 1.0,  0.0, };
+    double b[] = { 1.0, -0.0, };
+    double c[] = { 1.0,  0.5, };
+
+    EXPECT( span<double>( a ) == span<double>( b ) );
+    EXPECT( span<double>( a ) <  span<double>( c ) );
+}
+
+CASE( "mismatch(): Allows to find the index of the first difference of two spans" )
+{
+    int a[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, };
+    int b[] = { 1, 2, 3, 4, 5, 0, 7, 8, 9, };
+
+    EXPECT( mismatch( span<int>( a ), span<int>( b ) ) == size_type( 5 ) );
+    EXPECT( mismatch( span<int>( a ), span<const int>( a ) ) == size_type( 9 ) );
+}
+
+CASE( "mismatch(): Allows to find the index of the first difference beyond 16 bytes" )
+{
+    char a[] = "abcdefghijklmnopqrstuvwxyz";
+    char b[] = "abcdefghijklmnopqrstuvwxyZ";
+
+    EXPECT( mismatch( ensure_z( a ), ensure_z( b ) ) == size_type( 25 ) );
+}
+
+CASE( "mismatch(): Yields the size of the shorter span when it is a prefix of the other" )
+{
+    int a[] = { 1, 2, 3, 4, 5, };
+
+    EXPECT( mismatch( span<int>( a ), span<int>( a ).first( 3 ) ) == size_type( 3 ) );
+    EXPECT( mismatch( span<int>( a ).first( 0 ), span<int>( a ) ) == size_type( 0 ) );
+}
+
+CASE( "find(): Allows to find the index of the first element equal to a value" )
+{
+    int a[] = { 1, 2, 3, 4, 5, 3, };
+
+    EXPECT( find( span<int>( a ), 3 ) == size_type( 2 ) );
+    EXPECT( find( span<const int>( a ).subspan( 3 ), 3 ) == size_type( 2 ) );
+}
+
+CASE( "find(): Yields the size of the span if no element is equal to the value" )
+{
+    int a[] = { 1, 2, 3, 4, 5, };
+
+    EXPECT( find( span<int>( a ), 7 ) == size_type( 5 ) );
+    EXPECT( find( span<int>( a ).first( 0 ), 1 ) == size_type( 0 ) );
+    EXPECT( span<int>( a ).subspan( find( span<int>( a ), 7 ) ).empty() );
+}
+
+CASE( "find(): Allows to find a value at any offset in spans of any length" )
+{
+    unsigned char c[80] = { 0 };
+    short         s[80] = { 0 };
+    int           i[80] = { 0 };
+    byte          b[80];
+
+    std::fill( b, b + 80, to_byte( 0 ) );
+
+    bool all_found = true;
+
+    for ( size_t n = 0; n <= 80; ++n )
+    {
+        for ( size_t k = 0; k <= n; ++k )
+        {
+            if ( k < n )
+                c[k] = 7, s[k] = 7, i[k] = 7, b[k] = to_byte( 7 );
+
+            all_found = all_found
+                && find( span<const unsigned char>( c, n ), 7 ) == k
+                && find( span<const short        >( s, n ), 7 ) == k
+                && find( span<const int          >( i, n ), 7 ) == k
+                && find( span<const byte         >( b, n ), to_byte( 7 ) ) == k;
+
+            if ( k < n )
+                c[k] = 0, s[k] = 0, i[k] = 0, b[k] = to_byte( 0 );
+        }
+    }
+    EXPECT( all_found );
+}
+
+CASE( "find(): Allows to find a value that is not compared bytewise" )
+{
+    double a[] = { 1.0, -0.0, 2.0, };
+
+    EXPECT( find( span<double>( a ), 0.0 ) == size_type( 1 ) );
+    EXPECT( find( ensure_z( "hello, world" ), 'w' ) == size_type( 7 ) );
+}
+
+CASE( "find_if_equal_any(): Allows to find the index of the first element equal to any of some values" )
+{
+    char text[] = "key = value; another = value,more";
+    char const few [] = { ';', ',', };
+    char const many[] = { 'x', 'z', 'q', 'j', ',', '=', };
+    char const none[] = { '!', };
+
+    cstring_span s = ensure_z( text );
+
+    EXPECT( find_if_equal_any( s, span<const char>( few  ) ) == size_type( 11 ) );
+    EXPECT( find_if_equal_any( s, span<const char>( many ) ) == size_type(  4 ) );
+    EXPECT( find_if_equal_any( s, span<const char>( none ) ) == s.size() );
+    EXPECT( find_if_equal_any( s, span<const char>() )       == s.size() );
+    EXPECT( find_if_equal_any( s.first( 3 ), span<const char>( many ) ) == size_type( 3 ) );
+}
+
+CASE( "count(): Allows to count the elements equal to a value" )
+{
+    unsigned char c[80];
+    int           i[80];
+
+    for ( size_t k = 0; k < 80; ++k )
+        c[k] = static_cast<unsigned char>( k % 3 ), i[k] = int( k % 3 );
+
+    bool all_counted = true;
+
+    for ( size_t n = 0; n <= 80; ++n )
+    {
+        all_counted = all_counted
+            && count( span<const unsigned char>( c, n ), 0 ) == ( n + 2 ) / 3
+            && count( span<const int          >( i, n ), 1 ) == ( n + 1 ) / 3;
+    }
+    EXPECT( all_counted );
+}
+
+CASE( "contains(): Allows to test whether a span contains a value" )
+{
+    int a[] = { 1, 2, 3, 4, 5, };
+
+    EXPECT(     contains( span<int>( a ), 5 ) );
+    EXPECT_NOT( contains( span<int>( a ), 6 ) );
+}
+
+CASE( "find(): Allows to find the offset of the first occurrence of a subspan" )
+{
+    char text[] = "GET /index.html HTTP/1.1 200; GET /favicon.ico HTTP/1.1 404";
+    int  a[] = { 1, 2, 3, 1, 2, 3, };
+    int  b[] = { 2, 3, };
+
+    cstring_span s = ensure_z( text );
+
+    EXPECT( find( s, ensure_z( "GET"  ) ) == size_type(  0 ) );
+    EXPECT( find( s, ensure_z( "HTTP" ) ) == size_type( 16 ) );
+    EXPECT( find( s, ensure_z( "404"  ) ) == size_type( 56 ) );
+    EXPECT( find( s, ensure_z( "POST" ) ) == s.size() );
+    EXPECT( find( s, ensure_z( ""     ) ) == size_type(  0 ) );
+    EXPECT( find( s.first( 2 ), ensure_z( "GET" ) ) == size_type( 2 ) );
+    EXPECT( find( span<int>( a ), span<const int>( b ) ) == size_type( 1 ) );
+}
+
+CASE( "find(): Allows to find a subspan at any offset in spans of any length" )
+{
+    std::string const text = "abracadabra, cadabra, abracadabra, arbadacarba, " + std::string( 60, 'a' ) + "abracadabra, cadabra";
+    char const * const needles[] = { "a", "ab", "abra", "cadabra", "dacarba", "aaaab", "abracadabra", "bb", "abracadabrx", };
+
+    bool all_found = true;
+
+    for ( size_t n = 0; n <= text.size(); ++n )
+    {
+        std::string const haystack = text.substr( 0, n );
+
+        for ( size_t k = 0; k < gsl_DIMENSION_OF( needles ); ++k )
+        {
+            std::string const needle = needles[k];
+            size_t const first = haystack.find ( needle );
+            size_t const last  = haystack.rfind( needle );
+
+            all_found = all_found
+                && find ( span<const char>( haystack.data(), n ), ensure_z( needles[k] ) ) == ( first == std::string::npos ? n : first )
+                && rfind( span<const char>( haystack.data(), n ), ensure_z( needles[k] ) ) == ( last  == std::string::npos ? n : last  )
+                && find ( span<const char>( haystack.data(), n ).as_bytes(), ensure_z( needles[k] ).as_bytes() ) == ( first == std::string::npos ? n : first );
+        }
+    }
+    EXPECT( all_found );
+}
+
+CASE( "rfind(): Allows to find the offset of the last occurrence of a subspan" )
+{
+    char text[] = "GET /index.html HTTP/1.1 200; GET /favicon.ico HTTP/1.1 404";
+    int  a[] = { 1, 2, 3, 1, 2, 3, };
+    int  b[] = { 2, 3, };
+
+    cstring_span s = ensure_z( text );
+
+    EXPECT( rfind( s, ensure_z( "GET"  ) ) == size_type( 30 ) );
+    EXPECT( rfind( s, ensure_z( "POST" ) ) == s.size() );
+    EXPECT( rfind( s, ensure_z( ""     ) ) == s.size() );
+    EXPECT( rfind( span<int>( a ), span<const int>( b ) ) == size_type( 4 ) );
+}
+
+namespace {
+
+// collects the offsets passed to it:
+
+struct offsets
+{
+    std::vector<size_t> * found;
+
+    void operator()( size_t offset ) const
+    {
+        found->push_back( offset );
+    }
+};
+}
+
+CASE( "find_all(): Allows to visit the offsets of all non-overlapping occurrences of a subspan" )
+{
+    char text[] = "aaaaa; b=1; b=2; bb=3";
+    std::vector<size_t> found;
+    offsets const f = { &found };
+
+    EXPECT( find_all( ensure_z( text ), ensure_z( "aa"  ), f ) == size_type( 2 ) );
+    EXPECT( find_all( ensure_z( text ), ensure_z( "b="  ), f ) == size_type( 3 ) );
+    EXPECT( find_all( ensure_z( text ), ensure_z( "c="  ), f ) == size_type( 0 ) );
+
+    size_t const expected[] = { 0, 2, 7, 12, 18, };
+
+    EXPECT( found.size() == gsl_DIMENSION_OF( expected ) );
+    EXPECT( std::equal( found.begin(), found.end(), expected ) );
+}
+
+CASE( "find_all(): Terminates on an empty needle" )
+{
+    char text[] = "abc";
+    std::vector<size_t> found;
+    offsets const f = { &found };
+
+    EXPECT_THROWS( find_all( ensure_z( text ), ensure_z( "" ), f ) );
+}
+
 CASE( "span<>: Allows to test for empty span via empty(), empty case" )
 {
     span<int> v;
@@ -1058,6 +1329,77 @@ CASE( "span<>: Allows to copy a span to another span of a different element type
     }
 }
 
+CASE( "span<>: Allows to copy a span to an overlapping span of the same trivially copyable type" )
+{
+    int a[] = { 1, 2, 3, 4, 5, };
+    int b[] = { 1, 2, 3, 4, 5, };
+
+    span<int> v( a );
+    span<int> w( b );
+
+    copy( v.first( 4 ), v.last( 4 ) );
+    copy( w.last( 4 ), w.first( 4 ) );
+
+    int ea[] = { 1, 1, 2, 3, 4, };
+    int eb[] = { 2, 3, 4, 5, 5, };
+
+    EXPECT( v == span<int>( ea ) );
+    EXPECT( w == span<int>( eb ) );
+}
+
+CASE( "span<>: Allows to copy a large span of a trivially copyable type" )
+{
+    std::vector<int> a( 64 * 1024 );
+    std::vector<int> b( a.size() + 1 );
+
+    for ( size_t i = 0; i < a.size(); ++i )
+    {
+        a[i] = static_cast<int>( i );
+    }
+
+    span<const int> src( with_container, a );
+    span<      int> dst( with_container, b );
+
+    copy( src, dst.subspan( 1 ) );
+
+    EXPECT( src == span<const int>( dst.subspan( 1 ) ) );
+    EXPECT( b[0] == 0 );
+}
+
+CASE( "span<>: Allows to copy a span beyond the non-temporal copy threshold exactly" )
+{
+    size_t const n = gsl_CONFIG_NONTEMPORAL_COPY_THRESHOLD + 4099;
+
+    std::vector<unsigned char> a( n + 3 );
+    std::vector<unsigned char> b( n + 2, 0xAA );
+
+    for ( size_t i = 0; i < a.size(); ++i )
+    {
+        a[i] = static_cast<unsigned char>( i * 7 + i / 251 );
+    }
+
+    span<const unsigned char> src = span<const unsigned char>( with_container, a ).subspan( 3, n );
+    span<      unsigned char> dst = span<      unsigned char>( with_container, b ).subspan( 1, n );
+
+    copy( src, dst );
+
+    EXPECT( src == span<const unsigned char>( dst ) );
+    EXPECT( b[0] == 0xAA );
+    EXPECT( b[n + 1] == 0xAA );
+}
+
+CASE( "span<>: Allows to copy a span of a type that is not trivially copyable" )
+{
+    std::string a[] = { "a", "b", "c", };
+    std::string b[] = { "",  "",  "",  "", };
+
+    copy( span<std::string>( a ), span<std::string>( b ) );
+
+    EXPECT( b[0] == "a" );
+    EXPECT( b[2] == "c" );
+    EXPECT( b[3] == ""  );
+}
+
 CASE( "span<>: Allows building from two pointers" )
 {
     int arr[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, };
@@ -1170,4 +1512,421 @@ CASE( "span<>: Allows building from a const container (std::vector<>)" )
     EXPECT( std::equal( v.begin(), v.end(), vec.begin() ) );
 }
 
+CASE( "span<T, N>: Disallows creation of a sub span exceeding the extent (define gsl_CONFIG_CONFIRMS_COMPILATION_ERRORS)" )
+{
+#if gsl_CONFIG_CONFIRMS_COMPILATION_ERRORS
+    int arr[] = { 1, 2, 3, };
+    span<int, 3> v( arr );
+
+    (void) v.first<4>();
+    (void) v.last<4>();
+    (void) v.subspan<2, 2>();
+#endif
+}
+
+CASE( "span<T, N>: Terminates construction from a pointer and a size other than N" )
+{
+    struct F { static void blow() { int arr[] = { 1, 2, 3, }; span<int, 3> v( arr, 2 ); } };
+
+    EXPECT_THROWS( F::blow() );
+}
+
+CASE( "span<T, N>: Terminates construction from a dynamic span of a size other than N" )
+{
+    struct F { static void blow() { int arr[] = { 1, 2, 3, }; span<int, 2> v(( span<int>( arr ) )); } };
+
+    EXPECT_THROWS( F::blow() );
+}
+
+CASE( "span<T, N>: Terminates access outside the span" )
+{
+    struct F { 
+        static void blow_ix(int i) { int arr[] = { 1, 2, 3, }; span<int, 3> v( arr ); (void) v[i]; } 
+        static void blow_at(int i) { int arr[] = { 1, 2, 3, }; span<int, 3> v( arr ); (void) v.at(i); } 
+    };
+
+    EXPECT_NO_THROW( F::blow_ix(2) );
+    EXPECT_NO_THROW( F::blow_at(2) );
+    EXPECT_THROWS(   F::blow_ix(3) );
+    EXPECT_THROWS(   F::blow_at(3) );
+}
+
+CASE( "span<T, N>: Only stores a pointer" )
+{
+    EXPECT( sizeof( span<int, 3> ) == sizeof( int * ) );
+}
+
+CASE( "span<T, N>: Allows construction from a C-array" )
+{
+    int arr[] = { 1, 2, 3, 4, 5, };
+
+    span<      int, 5> v( arr );
+    span<const int, 5> w( arr );
+
+    EXPECT( v.size() == size_type( 5 ) );
+    EXPECT( w.size() == size_type( 5 ) );
+    EXPECT( std::equal( v.begin(), v.end(), arr ) );
+    EXPECT( std::equal( w.begin(), w.end(), arr ) );
+}
+
+CASE( "span<T, N>: Allows construction from a std::array<> (C++11)" )
+{
+# if gsl_HAVE_ARRAY
+    std::array<int,5> arr = {{ 1, 2, 3, 4, 5, }};
+    std::array<int,5> const & carr = arr;
+
+    span<      int, 5> v( arr );
+    span<const int, 5> w( carr );
+
+    EXPECT( std::equal( v.begin(), v.end(), arr.begin() ) );
+    EXPECT( std::equal( w.begin(), w.end(), arr.begin() ) );
+#else
+    EXPECT( !!"std::array<> is not available (no C++11)" );
+#endif
+}
+
+CASE( "span<T, N>: Allows construction from a pointer and a size of N" )
+{
+    int arr[] = { 1, 2, 3, 4, 5, };
+
+    span<int, 5> v( &arr[0], 5 );
+    span<int, 5> w( &arr[0], &arr[0] + 5 );
+
+    EXPECT( std::equal( v.begin(), v.end(), arr ) );
+    EXPECT( std::equal( w.begin(), w.end(), arr ) );
+}
+
+CASE( "span<T, N>: Allows explicit construction from a dynamic span of size N" )
+{
+    int arr[] = { 1, 2, 3, 4, 5, };
+
+    span<const int, 5> v(( span<int>( arr ) ));
+
+    EXPECT( std::equal( v.begin(), v.end(), arr ) );
+}
+
+CASE( "span<T, N>: Allows implicit conversion to a dynamic span" )
+{
+    int arr[] = { 1, 2, 3, 4, 5, };
+    span<int, 5> v( arr );
+
+    span<      int> x = v;
+    span<const int> y = v;
+
+    EXPECT( x.size() == size_type( 5 ) );
+    EXPECT( y.size() == size_type( 5 ) );
+    EXPECT( x == v );
+    EXPECT( y == span<const int>( v ) );
+}
+
+CASE( "span<T, N>: Allows creation of fixed-extent sub spans" )
+{
+    int arr[] = { 1, 2, 3, 4, 5, };
+    span<int, 5> v( arr );
+
+    span<int, 2> f = v.first<2>();
+    span<int, 2> l = v.last<2>();
+    span<int, 3> s = v.subspan<1, 3>();
+
+    EXPECT( f.size() == size_type( 2 ) );
+    EXPECT( l.size() == size_type( 2 ) );
+    EXPECT( s.size() == size_type( 3 ) );
+    EXPECT( std::equal( f.begin(), f.end(), arr     ) );
+    EXPECT( std::equal( l.begin(), l.end(), arr + 3 ) );
+    EXPECT( std::equal( s.begin(), s.end(), arr + 1 ) );
+}
+
+CASE( "span<T, N>: Allows creation of dynamic-extent sub spans" )
+{
+    int arr[] = { 1, 2, 3, 4, 5, };
+    span<int, 5> v( arr );
+
+    span<int> f = v.first( 2 );
+    span<int> l = v.last( 2 );
+    span<int> s = v.subspan( 1, 3 );
+
+    EXPECT( std::equal( f.begin(), f.end(), arr     ) );
+    EXPECT( std::equal( l.begin(), l.end(), arr + 3 ) );
+    EXPECT( std::equal( s.begin(), s.end(), arr + 1 ) );
+}
+
+CASE( "span<T, N>: Allows to obtain its extent and sizes at compile time" )
+{
+    int arr[] = { 1, 2, 3, 4, 5, };
+    span<int, 5> v( arr );
+
+    EXPECT(( span<int, 5>::extent == size_type( 5 ) ));
+    EXPECT( span<int   >::extent == dynamic_extent );
+    EXPECT( v.size()  == size_type( 5 ) );
+    EXPECT( v.bytes() == size_type( 5 * sizeof( int ) ) );
+    EXPECT( v.as_bytes().size() == size_type( 5 * sizeof( int ) ) );
+}
+
+CASE( "span<>: Allows creation of a fixed-extent sub span" )
+{
+    int arr[] = { 1, 2, 3, 4, 5, };
+    span<int> v( arr );
+
+    span<int, 2> f = v.first<2>();
+    span<int, 2> l = v.last<2>();
+    span<int, 3> s = v.subspan<1, 3>();
+
+    EXPECT( std::equal( f.begin(), f.end(), arr     ) );
+    EXPECT( std::equal( l.begin(), l.end(), arr + 3 ) );
+    EXPECT( std::equal( s.begin(), s.end(), arr + 1 ) );
+}
+
+CASE( "span<>: Terminates creation of a fixed-extent sub span exceeding the span" )
+{
+    struct F { 
+        static void blow_first() { int arr[] = { 1, 2, 3, }; span<int> v( arr ); (void) v.first<4>(); } 
+        static void blow_last()  { int arr[] = { 1, 2, 3, }; span<int> v( arr ); (void) v.last<4>(); } 
+        static void blow_sub()   { int arr[] = { 1, 2, 3, }; span<int> v( arr ); (void) v.subspan<2, 2>(); } 
+    };
+
+    EXPECT_THROWS( F::blow_first() );
+    EXPECT_THROWS( F::blow_last()  );
+    EXPECT_THROWS( F::blow_sub()   );
+}
+
+CASE( "checked_range<>: Terminates creation outside the span" )
+{
+    struct F { 
+        static void blow_order() { int arr[] = { 1, 2, 3, }; span<int> v( arr ); (void) as_checked_range( v, 2, 1 ); } 
+        static void blow_last()  { int arr[] = { 1, 2, 3, }; span<int> v( arr ); (void) as_checked_range( v, 1, 4 ); } 
+        static void blow_both()  { int arr[] = { 1, 2, 3, }; span<int> v( arr ); (void) as_checked_range( v, 100, 100 ); }
+    };
+
+    EXPECT_THROWS( F::blow_order() );
+    EXPECT_THROWS( F::blow_last()  );
+    EXPECT_THROWS( F::blow_both()  );
+}
+
+CASE( "checked_range<>: Allows iteration over all elements of a span" )
+{
+    int arr[] = { 1, 2, 3, 4, 5, };
+    span<int> v( arr );
+
+    checked_range<int> r = as_checked_range( v );
+
+    EXPECT( r.size() == size_type( 5 ) );
+    EXPECT( std::equal( r.begin(), r.end(), arr ) );
+}
+
+CASE( "checked_range<>: Allows iteration over a part of a span" )
+{
+    int arr[] = { 1, 2, 3, 4, 5, };
+    span<int> v( arr );
+
+    checked_range<int> r = as_checked_range( v, 1, 4 );
+
+    EXPECT( r.size() == size_type( 3 ) );
+    EXPECT( std::equal( r.begin(), r.end(), arr + 1 ) );
+    EXPECT( r.as_span() == v.subspan( 1, 3 ) );
+}
+
+CASE( "checked_range<>: Allows indexing relative to the start of the range" )
+{
+    int arr[] = { 1, 2, 3, 4, 5, };
+    span<int> v( arr );
+
+    checked_range<int> r = as_checked_range( v, 2, 5 );
+
+    for ( size_t i = 0; i < r.size(); ++i )
+    {
+        r[i] *= 10;
+    }
+
+    EXPECT( arr[1] ==  2 );
+    EXPECT( arr[2] == 30 );
+    EXPECT( arr[4] == 50 );
+}
+
+CASE( "checked_range<>: Allows an empty range at the end of a span" )
+{
+    int arr[] = { 1, 2, 3, };
+    span<int, 3> v( arr );
+
+    checked_range<const int> r = as_checked_range( span<const int>( v ), 3, 3 );
+
+    EXPECT( r.empty() );
+    EXPECT( r.begin() == r.end() );
+}
+
+CASE( "checked_range<>: Allows range-for iteration (C++11)" )
+{
+#if gsl_CPP11_OR_GREATER
+    int arr[] = { 1, 2, 3, 4, 5, };
+    span<int> v( arr );
+
+    int sum = 0;
+    for ( int x : as_checked_range( v, 0, 3 ) )
+        sum += x;
+
+    EXPECT( sum == 6 );
+#else
+    EXPECT( !!"range-for is not available (no C++11)" );
+#endif
+}
+
+CASE( "chunk_view<>: Allows to iterate over chunks of a span, the last one shorter" )
+{
+    int arr[] = { 1, 2, 3, 4, 5, 6, 7, };
+    span<int> v( arr );
+
+    chunk_view<int> c = chunks( v, 3 );
+
+    EXPECT( c.size() == size_type( 3 ) );
+    EXPECT( c[0] == v.subspan( 0, 3 ) );
+    EXPECT( c[2] == v.subspan( 6, 1 ) );
+    EXPECT( c.body() == v.first( 6 ) );
+    EXPECT( c.tail() == v.last( 1 ) );
+
+    int n = 0;
+    for ( chunk_view<int>::iterator it = c.begin(); it != c.end(); ++it, ++n )
+        EXPECT( ( *it ).data() == arr + 3 * n );
+
+    EXPECT( n == 3 );
+}
+
+CASE( "chunk_view<>: Allows chunks of an empty span and chunks without a tail" )
+{
+    int arr[] = { 1, 2, 3, 4, };
+    span<int> v( arr );
+
+    EXPECT( chunks( v.first( 0 ), 3 ).empty() );
+    EXPECT( !( chunks( v.first( 0 ), 3 ).begin() != chunks( v.first( 0 ), 3 ).end() ) );
+    EXPECT( chunks( v, 2 ).size() == size_type( 2 ) );
+    EXPECT( chunks( v, 2 ).tail().empty() );
+}
+
+CASE( "window_view<>: Allows to iterate over windows of a span with a step" )
+{
+    int arr[] = { 1, 2, 3, 4, 5, 6, 7, };
+    span<int> v( arr );
+
+    window_view<int> w = windows( v, 3, 2 );
+
+    EXPECT( w.size() == size_type( 3 ) );
+    EXPECT( w[0] == v.subspan( 0, 3 ) );
+    EXPECT( w[2] == v.subspan( 4, 3 ) );
+
+    EXPECT( windows( v, 3 ).size() == size_type( 5 ) );
+    EXPECT( windows( v, 8 ).empty() );
+    EXPECT( windows( v, 7, 5 ).size() == size_type( 1 ) );
+}
+
+CASE( "aligned_chunk_view<>: Allows to split a span into head, aligned chunks and tail" )
+{
+    dyn_array<float, 32> arr( 21 );
+    span<float> v( arr.data(), arr.size() );
+
+    aligned_chunk_view<float> a = aligned_chunks( v.subspan( 3 ), 16 );
+
+    EXPECT( a.chunk_size() == size_type( 4 ) );
+    EXPECT( a.head() == v.subspan( 3, 1 ) );
+    EXPECT( a.body() == v.subspan( 4, 16 ) );
+    EXPECT( a.tail() == v.subspan( 20, 1 ) );
+    EXPECT( a.size() == size_type( 4 ) );
+    EXPECT( a[1] == v.subspan( 8, 4 ) );
+
+    for ( aligned_chunk_view<float>::iterator it = a.begin(); it != a.end(); ++it )
+        EXPECT( reinterpret_cast<size_t>( ( *it ).data() ) % 16 == 0u );
+}
+
+namespace {
+
+// an element of two bytes without alignment requirement:
+
+struct char_pair { char a, b; };
+}
+
+CASE( "aligned_chunk_view<>: Allows a span too short for a chunk or that cannot reach the alignment" )
+{
+    char arr[64] = { 0 };
+    span<char> v( arr );
+
+    size_t const head = ( 16 - reinterpret_cast<size_t>( arr ) % 16 ) % 16;
+
+    aligned_chunk_view<char> a = aligned_chunks( v.subspan( head, 15 ), 16 );
+
+    EXPECT( a.empty() );
+    EXPECT( a.head().empty() );
+    EXPECT( a.tail().size() == size_type( 15 ) );
+
+    span<char_pair> odd( reinterpret_cast<char_pair *>( arr + head + 1 ), 16 );
+
+    EXPECT( aligned_chunks( odd, 16 ).empty() );
+    EXPECT( aligned_chunks( odd, 16 ).head().size() == size_type( 16 ) );
+}
+
+CASE( "chunk_view<>, window_view<>, aligned_chunk_view<>: Terminate on a size, step or alignment of zero or an invalid alignment" )
+{
+    int arr[] = { 1, 2, 3, };
+    span<int> v( arr );
+
+    EXPECT_THROWS( chunks( v, 0 ) );
+    EXPECT_THROWS( windows( v, 0 ) );
+    EXPECT_THROWS( windows( v, 1, 0 ) );
+    EXPECT_THROWS( aligned_chunks( v, 0 ) );
+    EXPECT_THROWS( aligned_chunks( v, 24 ) );
+    EXPECT_THROWS( aligned_chunks( v, 2 ) );
+}
+
+CASE( "chunk_view<>, window_view<>, aligned_chunk_view<>: Evaluate no contract per sub-span" )
+{
+#if gsl_CONFIG_CONTRACT_COUNTERS
+    dyn_array<float, 32> arr( 45 );
+    span<float> v( arr.data(), arr.size() );
+
+    chunk_view<float> c = chunks( v, 4 );
+    window_view<float> w = windows( v, 8, 3 );
+    aligned_chunk_view<float> a = aligned_chunks( v.subspan( 1 ), 16 );
+
+    reset_contract_counters();
+
+    size_t n = 0;
+    for ( chunk_view<float>::iterator it = c.begin(); it != c.end(); ++it )
+        n += ( *it ).size();
+    for ( window_view<float>::iterator it = w.begin(); it != w.end(); ++it )
+        n += ( *it ).size();
+    for ( aligned_chunk_view<float>::iterator it = a.begin(); it != a.end(); ++it )
+        n += ( *it ).size();
+
+    n += c.body().size() + c.tail().size() + a.head().size() + a.body().size() + a.tail().size();
+
+    std::vector<contract_counter> const counters = contract_counters();
+
+    unsigned long long evaluations = 0;
+    for ( size_t i = 0; i < counters.size(); ++i )
+        evaluations += counters[i].evaluations;
+
+    EXPECT( n == size_type( 45 + 13 * 8 + 40 + 45 + 44 ) );
+    EXPECT( evaluations == 0u );
+#else
+    EXPECT( !!"contract counters are not enabled (gsl_CONFIG_CONTRACT_COUNTERS)" );
+#endif
+}
+
+CASE( "chunk_view<>, window_view<>: Allow range-for iteration (C++11)" )
+{
+#if gsl_CPP11_OR_GREATER
+    int arr[] = { 1, 2, 3, 4, 5, };
+    span<int> v( arr );
+
+    int sum = 0;
+    for ( span<int> c : chunks( v, 2 ) )
+        sum += c[0];
+
+    int windows_sum = 0;
+    for ( span<int> w : windows( v, 2 ) )
+        windows_sum += w[1];
+
+    EXPECT( sum == 1 + 3 + 5 );
+    EXPECT( windows_sum == 2 + 3 + 4 + 5 );
+#else
+    EXPECT( !!"range-for is not available (no C++11)" );
+#endif
+}
+
 // end of file
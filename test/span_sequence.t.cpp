@@ -0,0 +1,209 @@
+//
+// gsl-lite is based on GSL: Guideline Support Library,
+// https://github.com/microsoft/gsl
+//
+// Copyright (c) 2015 Martin Moene
+// Copyright (c) 2015 Microsoft Corporation. All rights reserved.
+//
+// This code is licensed under the MIT License (MIT).
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "gsl-lite.t.h"
+
+#if gsl_HAVE_UIO
+
+#include <fcntl.h>
+
+namespace {
+
+// a pipe, closed on destruction:
+
+struct pipe_fds
+{
+    pipe_fds( bool non_blocking = false )
+    {
+        if ( ::pipe( fd ) != 0 )
+            throw std::runtime_error( "pipe" );
+
+        if ( non_blocking )
+        {
+            ::fcntl( fd[0], F_SETFL, O_NONBLOCK );
+            ::fcntl( fd[1], F_SETFL, O_NONBLOCK );
+        }
+    }
+
+    ~pipe_fds()
+    {
+        ::close( fd[0] );
+        ::close( fd[1] );
+    }
+
+    int in()  const { return fd[0]; }
+    int out() const { return fd[1]; }
+
+    int fd[2];
+};
+
+// read what is available without blocking:
+
+std::string drain( int fd )
+{
+    std::string result;
+    char buffer[4096];
+
+    for ( ssize_t n; ( n = ::read( fd, buffer, sizeof( buffer ) ) ) > 0; )
+        result.append( buffer, static_cast<size_t>( n ) );
+
+    return result;
+}
+}
+#endif
+
+CASE( "span_sequence<>: Allows to gather spans of different element types" )
+{
+#if gsl_HAVE_UIO
+    char const header[] = "head";
+    int body[] = { 1, 2, 3, };
+
+    span_sequence<4> s;
+    s.push_back( span<const char>( header, 4 ) ).push_back( span<int>( body ) );
+
+    EXPECT( s.size() == 2u );
+    EXPECT( s.size_bytes() == 4 + sizeof( body ) );
+    EXPECT( s.data()[1].iov_base == static_cast<void *>( body ) );
+    EXPECT( s.data()[1].iov_len  == sizeof( body ) );
+    EXPECT( !s.is_writeable() );
+#else
+    EXPECT( !!"span_sequence is not available (no POSIX)" );
+#endif
+}
+
+CASE( "span_sequence<>: Allows to advance past the bytes of several ranges" )
+{
+#if gsl_HAVE_UIO
+    char a[] = "abc", b[] = "", c[] = "defgh";
+
+    span_sequence<3> s;
+    s.push_back( span<char>( a, 3 ) ).push_back( span<char>( b, size_t( 0 ) ) ).push_back( span<char>( c, 5 ) );
+
+    EXPECT( s.is_writeable() );
+
+    s.advance( 1 );
+
+    EXPECT( s.size() == 3u );
+    EXPECT( *static_cast<char *>( s.data()->iov_base ) == 'b' );
+
+    s.advance( 2 );
+
+    EXPECT( s.size() == 1u );
+    EXPECT( s.size_bytes() == 5u );
+
+    s.advance( 4 );
+
+    EXPECT( *static_cast<char *>( s.data()->iov_base ) == 'h' );
+
+    s.advance( 1 );
+
+    EXPECT( s.empty() );
+#else
+    EXPECT( !!"span_sequence is not available (no POSIX)" );
+#endif
+}
+
+CASE( "span_sequence<>: Allows to write spans with writev() and to read them back with readv()" )
+{
+#if gsl_HAVE_UIO
+    pipe_fds p;
+    char const text[] = "Hello, world!";
+
+    span_sequence<3> out;
+    out.push_back( span<const char>( text, 5 ) ).push_back( span<const char>( text + 5, 2 ) ).push_back( span<const char>( text + 7, 6 ) );
+
+    EXPECT( write_spans( p.out(), out ) == 13u );
+    EXPECT( out.empty() );
+
+    char hello[5], rest[10];
+
+    span_sequence<2> in;
+    in.push_back( span<char>( hello ) ).push_back( span<char>( rest ) );
+
+    ::close( p.fd[1] ); p.fd[1] = -1;
+
+    EXPECT( read_spans( p.in(), in ) == 13u );
+    EXPECT( in.size_bytes() == 2u );
+    EXPECT( std::string( hello, 5 ) == "Hello" );
+    EXPECT( std::string( rest, 8 ) == ", world!" );
+#else
+    EXPECT( !!"span_sequence is not available (no POSIX)" );
+#endif
+}
+
+CASE( "span_sequence<>: Allows to continue after a partial write" )
+{
+#if gsl_HAVE_UIO
+    pipe_fds p( true );
+    std::string const header( 100, 'h' ), body( 1000 * 1000, 'b' ), trailer( 10, 't' );
+
+    span_sequence<3> out;
+    out.push_back( span<const char>( header.data(), header.size() ) )
+       .push_back( span<const char>( body.data(), body.size() ) )
+       .push_back( span<const char>( trailer.data(), trailer.size() ) );
+
+    size_t const first = write_spans( p.out(), out );
+
+    EXPECT( first < header.size() + body.size() + trailer.size() );
+    EXPECT( out.size_bytes() == header.size() + body.size() + trailer.size() - first );
+
+    std::string received = drain( p.in() );
+
+    while ( !out.empty() )
+    {
+        write_spans( p.out(), out );
+        received += drain( p.in() );
+    }
+
+    EXPECT( received == header + body + trailer );
+#else
+    EXPECT( !!"span_sequence is not available (no POSIX)" );
+#endif
+}
+
+CASE( "span_sequence<>: Throws if the system call fails" )
+{
+#if gsl_HAVE_UIO
+    char buffer[4];
+
+    span_sequence<1> s;
+    s.push_back( span<char>( buffer ) );
+
+    EXPECT_THROWS( write_spans( -1, s ) );
+    EXPECT_THROWS( read_spans( -1, s ) );
+#else
+    EXPECT( !!"span_sequence is not available (no POSIX)" );
+#endif
+}
+
+CASE( "span_sequence<>: Terminates on more than N spans, on advancing too far and on reading into const elements" )
+{
+#if gsl_HAVE_UIO
+    char const text[] = "abc";
+
+    span_sequence<1> s;
+    s.push_back( span<const char>( text, 3 ) );
+
+    EXPECT_THROWS( s.push_back( span<const char>( text, 3 ) ) );
+    EXPECT_THROWS( s.advance( 4 ) );
+    EXPECT_THROWS( read_spans( 0, s ) );
+#else
+    EXPECT( !!"span_sequence is not available (no POSIX)" );
+#endif
+}
+
+// end of file
@@ -0,0 +1,202 @@
+//
+// gsl-lite is based on GSL: Guideline Support Library,
+// https://github.com/microsoft/gsl
+//
+// Copyright (c) 2015 Martin Moene
+// Copyright (c) 2015 Microsoft Corporation. All rights reserved.
+//
+// This code is licensed under the MIT License (MIT).
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "gsl-lite.t.h"
+
+#if gsl_HAVE_THREAD
+
+#include <thread>
+
+namespace {
+
+// assign first, first + 1, ... to the elements of s, return the next value:
+
+int fill( span<int> s, int first )
+{
+    for ( size_t i = 0; i < s.size(); ++i )
+        s[i] = first++;
+    return first;
+}
+
+// produce values 0..n-1 in batches of up to batch elements:
+
+void produce( spsc_ring<int> & ring, int n, size_t batch )
+{
+    for ( int next = 0; next < n; )
+    {
+        ring_regions<int> r = ring.reserve( (std::min)( batch, size_t( n - next ) ) );
+
+        next = fill( r.second, fill( r.first, next ) );
+        ring.commit( r.size() );
+
+        if ( r.empty() )
+            std::this_thread::yield();
+    }
+}
+}
+#endif
+
+CASE( "spsc_ring<>: Allows to create a ring with a capacity of a power of two" )
+{
+#if gsl_HAVE_THREAD
+    spsc_ring<int> a( 1 ), b( 100 ), c( 128 );
+
+    EXPECT( a.capacity() ==   1u );
+    EXPECT( b.capacity() == 128u );
+    EXPECT( c.capacity() == 128u );
+    EXPECT( c.empty() );
+#else
+    EXPECT( !!"spsc_ring is not available (no C++11)" );
+#endif
+}
+
+CASE( "spsc_ring<>: Allows to reserve and commit elements, to peek at them and to release them" )
+{
+#if gsl_HAVE_THREAD
+    spsc_ring<int> ring( 8 );
+
+    ring_regions<int> r = ring.reserve( 5 );
+
+    EXPECT( r.first.size()  == 5u );
+    EXPECT( r.second.size() == 0u );
+    EXPECT( ring.peek().empty() );
+
+    fill( r.first, 10 );
+    ring.commit( 3 );
+
+    EXPECT( ring.size() == 3u );
+
+    ring_regions<const int> s = ring.peek();
+
+    EXPECT( s.size() == 3u );
+    EXPECT( s.first[0] == 10 );
+    EXPECT( s.first[2] == 12 );
+
+    ring.release( 2 );
+
+    EXPECT( ring.size() == 1u );
+    EXPECT( ring.peek().first[0] == 12 );
+#else
+    EXPECT( !!"spsc_ring is not available (no C++11)" );
+#endif
+}
+
+CASE( "spsc_ring<>: Provides no more than the free elements and splits a region at the end of the memory" )
+{
+#if gsl_HAVE_THREAD
+    spsc_ring<int> ring( 8 );
+
+    ring.commit( ring.reserve( 6 ).size() );
+    ring.peek();
+    ring.release( 4 );
+
+    ring_regions<int> r = ring.reserve();
+
+    EXPECT( r.size() == 6u );
+    EXPECT( r.first.size()  == 2u );
+    EXPECT( r.second.size() == 4u );
+
+    fill( r.second, fill( r.first, 100 ) );
+    ring.commit( r.size() );
+
+    EXPECT( ring.reserve().empty() );
+
+    ring_regions<const int> s = ring.peek( 5 );
+
+    EXPECT( s.size() == 5u );
+    EXPECT( s.first.size() == 4u );
+    EXPECT( s.second[0] == 102 );
+#else
+    EXPECT( !!"spsc_ring is not available (no C++11)" );
+#endif
+}
+
+CASE( "spsc_ring<>: Allows to push and pop single elements" )
+{
+#if gsl_HAVE_THREAD
+    spsc_ring<int> ring( 2 );
+    int value = 0;
+
+    EXPECT( !ring.try_pop( value ) );
+    EXPECT(  ring.try_push( 1 ) );
+    EXPECT(  ring.try_push( 2 ) );
+    EXPECT( !ring.try_push( 3 ) );
+    EXPECT(  ring.try_pop( value ) );
+    EXPECT( value == 1 );
+    EXPECT(  ring.try_push( 3 ) );
+    EXPECT(  ring.try_pop( value ) );
+    EXPECT(  ring.try_pop( value ) );
+    EXPECT( value == 3 );
+#else
+    EXPECT( !!"spsc_ring is not available (no C++11)" );
+#endif
+}
+
+CASE( "spsc_ring<>: Allows to transfer elements in order from one thread to another" )
+{
+#if gsl_HAVE_THREAD
+    int const n = 100 * 1000;
+    spsc_ring<int> ring( 64 );
+
+    std::thread producer( produce, std::ref( ring ), n, size_t( 7 ) );
+
+    int expected = 0;
+    bool in_order = true;
+
+    while ( expected < n )
+    {
+        ring_regions<const int> s = ring.peek( 13 );
+
+        for ( size_t i = 0; i < s.first.size(); ++i )
+            in_order = in_order && s.first[i] == expected++;
+        for ( size_t i = 0; i < s.second.size(); ++i )
+            in_order = in_order && s.second[i] == expected++;
+
+        ring.release( s.size() );
+
+        if ( s.empty() )
+            std::this_thread::yield();
+    }
+    producer.join();
+
+    EXPECT( in_order );
+    EXPECT( ring.empty() );
+#else
+    EXPECT( !!"spsc_ring is not available (no C++11)" );
+#endif
+}
+
+CASE( "spsc_ring<>: Terminates on committing or releasing more than reserved or peeked" )
+{
+#if gsl_HAVE_THREAD
+    spsc_ring<int> ring( 8 );
+
+    ring.reserve( 2 );
+
+    EXPECT_THROWS( ring.commit( 3 ) );
+
+    ring.commit( 2 );
+    ring.peek( 1 );
+
+    EXPECT_THROWS( ring.release( 2 ) );
+    EXPECT_THROWS( spsc_ring<int>( 0 ) );
+#else
+    EXPECT( !!"spsc_ring is not available (no C++11)" );
+#endif
+}
+
+// end of file
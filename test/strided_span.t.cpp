@@ -0,0 +1,194 @@
+//
+// gsl-lite is based on GSL: Guideline Support Library,
+// https://github.com/microsoft/gsl
+//
+// Copyright (c) 2015 Martin Moene
+// Copyright (c) 2015 Microsoft Corporation. All rights reserved.
+//
+// This code is licensed under the MIT License (MIT).
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "gsl-lite.t.h"
+
+#include <numeric>
+
+namespace {
+
+struct record
+{
+    int    key;
+    double value;
+};
+
+}
+
+CASE( "strided_span<>: Allows to view every n-th element of a span" )
+{
+    int a[] = { 0, 100, 1, 101, 2, 102, 3, };
+
+    strided_span<int> s = as_strided_span( as_span( a ), 2 );
+
+    EXPECT( s.size() == 4u );
+    EXPECT( s[0] == 0 );
+    EXPECT( s[3] == 3 );
+    EXPECT( s.byte_stride() == std::ptrdiff_t( 2 * sizeof( int ) ) );
+}
+
+CASE( "strided_span<>: Allows to view a member of an array of structs" )
+{
+    record r[] = { { 1, 1.5 }, { 2, 2.5 }, { 3, 3.5 }, };
+
+    strided_span<int>    keys   = as_strided_span( as_span( r ), &record::key );
+    strided_span<double> values = as_strided_span( as_span( r ), &record::value );
+
+    EXPECT( keys.size() == 3u );
+    EXPECT( keys[2] == 3 );
+    EXPECT( values[1] == 2.5 );
+
+    keys[1] = 42;
+
+    EXPECT( r[1].key == 42 );
+}
+
+CASE( "strided_span<>: Allows to view a member of a const array of structs" )
+{
+    record const r[] = { { 1, 1.5 }, { 2, 2.5 }, };
+
+    strided_span<const int> keys = as_strided_span( as_span( r ), &record::key );
+
+    EXPECT( keys[1] == 2 );
+}
+
+CASE( "strided_span<>: Allows to iterate over its elements" )
+{
+    int a[] = { 0, -1, -1, 1, -1, -1, 2, -1, -1, };
+
+    strided_span<int> s( a, 3, 3 );
+
+    int expect = 0;
+    for ( strided_span<int>::iterator pos = s.begin(); pos != s.end(); ++pos )
+        EXPECT( *pos == expect++ );
+
+    EXPECT( s.end() - s.begin() == 3 );
+    EXPECT( s.begin()[2] == 2 );
+    EXPECT( std::accumulate( s.begin(), s.end(), 0 ) == 3 );
+}
+
+CASE( "strided_span<>: Allows a negative stride" )
+{
+    int a[] = { 0, 1, 2, 3, };
+
+    strided_span<int> s( &a[3], 4, -1 );
+
+    EXPECT( s[0] == 3 );
+    EXPECT( s[3] == 0 );
+}
+
+CASE( "strided_span<>: Allows to create a sub span" )
+{
+    int a[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, };
+
+    strided_span<int> s( a, 10, 1 );
+
+    EXPECT( s.first( 3 )[2] == 2 );
+    EXPECT( s.last( 3 )[0] == 7 );
+    EXPECT( s.subspan( 4 ).size() == 6u );
+    EXPECT( s.subspan( 4, 2 )[1] == 5 );
+    EXPECT( s.subspan( 1, 3, 3 ).size() == 3u );
+    EXPECT( s.subspan( 1, 3, 3 )[2] == 7 );
+    EXPECT( !s.subspan( 1, 3, 3 ).is_contiguous() );
+}
+
+CASE( "strided_span<>: Terminates on creation of a sub span out of bounds" )
+{
+    int a[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, };
+
+    strided_span<int> s( a, 10, 1 );
+
+    EXPECT_THROWS( s.first( 11 ) );
+    EXPECT_THROWS( s.subspan( 8, 3 ) );
+    EXPECT_THROWS( s.subspan( 1, 4, 3 ) );
+    EXPECT_THROWS( s.subspan( 10, 1, 1 ) );
+}
+
+CASE( "strided_span<>: Terminates on access out of bounds" )
+{
+    int a[] = { 0, 1, 2, 3, };
+
+    strided_span<int> s( a, 2, 2 );
+
+    EXPECT_THROWS( s[2] );
+}
+
+CASE( "gather(): Allows to copy the elements of a strided_span to a span" )
+{
+    std::vector<int> v( 3 * 100 );
+    for ( size_t i = 0; i < v.size(); ++i )
+        v[i] = static_cast<int>( i );
+
+    for ( size_t n = 0; n <= 100; n += 7 )
+    {
+        std::vector<int> out( n );
+
+        gather( strided_span<const int>( &v[1], n, 3 ), span<int>( with_container, out ) );
+
+        for ( size_t i = 0; i < n; ++i )
+            EXPECT( out[i] == static_cast<int>( 3 * i + 1 ) );
+    }
+}
+
+CASE( "gather(): Allows to copy a member of an array of structs to a span" )
+{
+    std::vector<record> r( 50 );
+    for ( size_t i = 0; i < r.size(); ++i )
+    {
+        r[i].key   = static_cast<int>( i );
+        r[i].value = 0.5 * static_cast<double>( i );
+    }
+
+    std::vector<int>    keys( r.size() );
+    std::vector<double> values( r.size() );
+
+    gather( as_strided_span( span<const record>( with_container, r ), &record::key   ), span<int>   ( with_container, keys ) );
+    gather( as_strided_span( span<const record>( with_container, r ), &record::value ), span<double>( with_container, values ) );
+
+    EXPECT( keys[49] == 49 );
+    EXPECT( values[49] == 24.5 );
+}
+
+CASE( "gather(): Terminates if the destination is too small" )
+{
+    int a[] = { 0, 1, 2, 3, };
+    int b[] = { 0, };
+
+    EXPECT_THROWS( gather( strided_span<int>( a, 2, 2 ), as_span( b ) ) );
+}
+
+CASE( "scatter(): Allows to copy the elements of a span to a strided_span" )
+{
+    int a[] = { 1, 2, 3, 4, 5, };
+    int b[10] = { 0 };
+
+    scatter( as_span( a ), strided_span<int>( b, 5, 2 ) );
+
+    EXPECT( b[0] == 1 );
+    EXPECT( b[1] == 0 );
+    EXPECT( b[8] == 5 );
+}
+
+CASE( "scatter(): Terminates if the destination is too small" )
+{
+    int a[] = { 1, 2, 3, };
+    int b[4] = { 0 };
+
+    EXPECT_THROWS( scatter( as_span( a ), strided_span<int>( b, 2, 2 ) ) );
+}
+
+// end of file
@@ -580,4 +580,62 @@ CASE( "ensure_z(): Allows to specify ultimate location of the sentinel and ensur
     EXPECT_THROWS( ensure_z( s, size_type( 3 ) ) );
 }
 
+CASE( "ensure_z(): Allows to build a string_span from a long C-string at any alignment" )
+{
+    char buf[ 100 ];
+
+    for ( size_t offset = 0; offset < 40; ++offset )
+    {
+        for ( size_t length = 0; offset + length < sizeof( buf ); ++length )
+        {
+            std::memset( buf, 'x', sizeof( buf ) );
+            buf[ offset + length ] = '\0';
+
+            EXPECT( ensure_z( &buf[offset] ).size() == size_type( length ) );
+        }
+    }
+}
+
+CASE( "ensure_z(): Allows to build a wstring_span from a long wide C-string at any alignment" )
+{
+    wchar_t buf[ 100 ];
+
+    for ( size_t offset = 0; offset < 20; ++offset )
+    {
+        for ( size_t length = 0; offset + length < gsl_DIMENSION_OF( buf ); ++length )
+        {
+            std::fill( buf, buf + gsl_DIMENSION_OF( buf ), L'x' );
+            buf[ offset + length ] = L'\0';
+
+            EXPECT( ensure_z( &buf[offset] ).size() == size_type( length ) );
+        }
+    }
+}
+
+CASE( "ensure_sentinel(): Allows to build a span up to a given sentinel value" )
+{
+    int  a[] = { 1, 2, 3, -1, 5, };
+    char s[] = "key=value";
+    byte b[] = { to_byte( 1 ), to_byte( 0xff ), to_byte( 2 ), };
+
+    EXPECT( ensure_sentinel( a, -1 ).size() == size_type( 3 ) );
+    EXPECT( ensure_sentinel( s, '=' ).size() == size_type( 3 ) );
+    EXPECT( ensure_sentinel( b, to_byte( 0xff ) ).size() == size_type( 1 ) );
+}
+
+CASE( "ensure_sentinel(): Allows the sentinel to be the element at max" )
+{
+    const char * s = "hello, world";
+
+    EXPECT( ensure_sentinel( s, ',', 5 ).size() == size_type( 5 ) );
+}
+
+CASE( "ensure_sentinel(): Terminates if the sentinel is not found before max elements" )
+{
+    const char * s = "hello, world";
+
+    EXPECT_THROWS( ensure_sentinel( s, ',', 4 ) );
+    EXPECT_THROWS( ensure_sentinel( s, '!', 12 ) );
+}
+
 // end of file
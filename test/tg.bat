@@ -1,6 +1,6 @@
 @setlocal
 @set std=%1
 @if "%std%"=="" set std=c++11
-g++ -std=%std% -O2 -Wall -Wextra -Wno-unused-parameter -fno-elide-constructors -o gsl-lite.t.exe -I../include/gsl -Dgsl_CONFIG_CONTRACT_VIOLATION_THROWS  -Dgsl_FEATURE_EXPERIMENTAL_RETURN_GUARD gsl-lite.t.cpp assert.t.cpp at.t.cpp byte.t.cpp issue.t.cpp not_null.t.cpp owner.t.cpp span.t.cpp string_span.t.cpp util.t.cpp && gsl-lite.t.exe
+g++ -std=%std% -O2 -Wall -Wextra -Wno-unused-parameter -fno-elide-constructors -o gsl-lite.t.exe -I../include/gsl -Dgsl_CONFIG_CONTRACT_VIOLATION_THROWS -Dgsl_FEATURE_CONCURRENCY=1 -Dgsl_FEATURE_OS_FACILITIES=1  -Dgsl_FEATURE_EXPERIMENTAL_RETURN_GUARD gsl-lite.t.cpp arena.t.cpp assert.t.cpp at.t.cpp byte.t.cpp chunk_reader.t.cpp dyn_array.t.cpp issue.t.cpp mapped_file.t.cpp mirrored_ring.t.cpp md_span.t.cpp not_null.t.cpp object_pool.t.cpp owner.t.cpp parallel.t.cpp radix_sort.t.cpp small_buffer.t.cpp span.t.cpp span_sequence.t.cpp spsc_ring.t.cpp strided_span.t.cpp string_span.t.cpp util.t.cpp && gsl-lite.t.exe
 @endlocal
 